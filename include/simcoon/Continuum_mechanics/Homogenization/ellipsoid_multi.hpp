@@ -47,24 +47,43 @@ protected:
     arma::mat T_in_loc;
     arma::mat T_in;
     
+    arma::mat Lt_m_T; //tangent modulus of the reference medium utilized for the last computation of T
+    arma::mat Lt_T; //tangent modulus of the phase utilized for the last computation of T
+    arma::vec geom_T; //geometry of the ellipsoid and integration settings (analytical, adaptive, mp, np) utilized for the last computation of T
+    int method_T; //fill method of the last computation of T (0 : none, 1 : fillT, 2 : fillT_iso)
+    int order_S; //order of the adaptive quadrature utilized for the last Eshelby tensor
+    
     static int mp;
     static int np;
     static arma::vec x;
     static arma::vec wx;
     static arma::vec y;
     static arma::vec wy;
+    static arma::mat xi; //unit integration directions (3 x mp*np), computed once from x and y
+    static arma::vec wxi; //weights of the integration directions
+    static bool analytical; //use the closed-form Eshelby tensors when the reference medium is isotropic and the ellipsoid is a spheroid
+    static bool adaptive; //use an adaptive order of the quadrature instead of the mp x np integration points
     
     ellipsoid_multi(); //default constructor
     ellipsoid_multi(const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::vec&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&); //Constructor with parameters
     ellipsoid_multi(const ellipsoid_multi&);	//Copy constructor
     ~ellipsoid_multi();
     
+    static void set_quadrature(const int &, const int &); //build the shared integration points; thread-safe, and left untouched if mp and np are unchanged
+    
+    arma::mat Eshelby_loc(const arma::mat&, const ellipsoid &); //Eshelby tensor for a tangent modulus of the matrix expressed in the coordinate system of the ellipsoid
+    arma::mat T_II_loc(const arma::mat&, const ellipsoid &); //Hill interaction tensor for a tangent modulus of the matrix expressed in the coordinate system of the ellipsoid
+    
     virtual void fillS_loc(const arma::mat&, const ellipsoid &); //need the L_global of the matrix
     virtual void fillP_loc(const arma::mat&, const ellipsoid &); //need the L_global of the matrix
     virtual void fillT(const arma::mat&, const arma::mat&, const ellipsoid &); //need the L_global of the matrix
     virtual void fillT_iso(const arma::mat&, const arma::mat&, const ellipsoid &); //need the L_global
     virtual void fillT_mec_in(const arma::mat&, const arma::mat&, const ellipsoid &); //need the L_global
     
+    bool T_uptodate(const arma::mat&, const arma::mat&, const ellipsoid &, const int &) const; //check if T is still valid for these tangent moduli (within precision_lazy_micro), this ellipsoid and the current integration settings
+    virtual bool updateT(const arma::mat&, const arma::mat&, const ellipsoid &); //fillT, only if the tangent moduli changed. Returns true if T is recomputed
+    virtual bool updateT_iso(const arma::mat&, const arma::mat&, const ellipsoid &); //fillT_iso, only if the tangent moduli changed. Returns true if T is recomputed
+    
 //    virtual void l2g_T();
 //    virtual void g2l_T();
     
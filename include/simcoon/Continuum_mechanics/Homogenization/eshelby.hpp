@@ -40,25 +40,61 @@ arma::mat Eshelby_prolate(const double &, const double &);
 //	Eshelby tensor determination. The oblate shape is oriented in such a way that the axis direction is the 1 direction. a1<a2=a3 here
 arma::mat Eshelby_oblate(const double &, const double &);
 
+//Check if a stiffness tensor is isotropic (relative tolerance), and returns the corresponding Poisson ratio
+bool check_isotropic(const arma::mat &, double &, const double & = 1.E-6);
+
+//Analytical Eshelby tensor for a spheroid (sphere, prolate, oblate, cylinder) in an isotropic medium. Returns false if no closed-form solution applies
+bool Eshelby_analytical(const arma::mat &, const double &, const double &, const double &, arma::mat &);
+
 //This methods is using the Voigt notations for the tensors.
 void calG(const double &, const double &, const double &, const double &, const double &, const arma::Mat<int> &, const arma::mat &, arma::mat &);
 
 //Weighted Gauss integration over a sphere to represent the integration over the ellipsoid
 void Gauss(arma::Mat<int> &, const arma::mat &, arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &, const int &);
 
+//Unit directions (3 x mp*np) and weights of the Gauss integration over the sphere, computed once for a given set of integration points
+void directions(arma::mat &, arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &, const int &);
+
+//Weighted Gauss integration over a sphere, evaluated at all the integration directions at once
+arma::mat Gauss(const arma::mat &, const double &, const double &, const double &, const arma::mat &, const arma::vec &);
+
+//Numerical Eshelby tensor determination, from precomputed integration directions
+arma::mat Eshelby(const arma::mat &, const double &, const double &, const double &, const arma::mat &, const arma::vec &);
+
 //Numerical Eshelby tensor determination
 arma::mat Eshelby(const arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &mp, const int &np);
 
 //Numerical Eshelby tensor determination
 arma::mat Eshelby(const arma::mat &, const double &, const double &, const double &, const int &, const int &);
+
+//Numerical Eshelby tensor determination with an adaptive order x order quadrature: starting from the given order, the order is doubled until the tensor converges to the relative tolerance. The order used is returned
+arma::mat Eshelby_adaptive(const arma::mat &, const double &, const double &, const double &, int &, const double & = precision_eshelby, const int & = maxorder_eshelby);
+
+//Eshelby tensor determination: closed-form solution when available, numerical integration otherwise
+arma::mat Eshelby_select(const arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &mp, const int &np);
+
+//Eshelby tensor determination: closed-form solution when available, numerical integration from precomputed integration directions otherwise
+arma::mat Eshelby_select(const arma::mat &, const double &, const double &, const double &, const arma::mat &, const arma::vec &);
     
 //arma::mat T_II_sphere(const double &, const double &); {
 
+//Numerical Hill Interaction tensor determination, from precomputed integration directions
+arma::mat T_II(const arma::mat &, const double &, const double &, const double &, const arma::mat &, const arma::vec &);
+
 //Numerical Hill Interaction tensor determination
 arma::mat T_II(const arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &, const int &);
 
 //Numerical Hill Interaction tensor determination
 arma::mat T_II(const arma::mat &, const double &, const double &, const double &, const int &, const int &);
+
+//Numerical Hill Interaction tensor determination with an adaptive order x order quadrature (see Eshelby_adaptive). The order used is returned
+arma::mat T_II_adaptive(const arma::mat &, const double &, const double &, const double &, int &, const double & = precision_eshelby, const int & = maxorder_eshelby);
+
+//Hill Interaction tensor determination: closed-form solution when available, numerical integration otherwise
+arma::mat T_II_select(const arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &, const int &);
+
+//Hill Interaction tensor determination: closed-form solution when available, numerical integration from precomputed integration directions otherwise
+arma::mat T_II_select(const arma::mat &, const double &, const double &, const double &, const arma::mat &, const arma::vec &);
     
 //This function computes the integration points and weights
 void points(arma::vec &, arma::vec &, arma::vec &, arma::vec &, const int &, const int &);
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <string>
 #include <armadillo>
+#include <simcoon/Simulation/Geometry/layer.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/phase_multi.hpp>
 
 namespace simcoon{
@@ -46,6 +47,13 @@ class layer_multi : public phase_multi
         //Part of the tangent modulus (usefull derivative)
         arma::mat Dnn;
         arma::mat Dnt;
+        arma::mat inv_Dnn;
+        arma::mat Lt_D; //tangent modulus utilized for the last computation of Dnn, Dnt
+        //Rotation from global to local of the layer: normal (1,4,5) and tangent (2,3,6) rows for the stress, and the strain rotation
+        arma::mat QS_n;
+        arma::mat QS_t;
+        arma::mat QE;
+        arma::vec angles_Q; //geometric angles of the layer utilized for the last computation of the rotations
         //Derivatives of the gradient / x1
         arma::mat dXn;
         arma::mat dXt;
@@ -59,6 +67,10 @@ class layer_multi : public phase_multi
         layer_multi(const layer_multi&);	//Copy constructor
         ~layer_multi();
     
+        virtual void updateQ(const layer &); //fill QS_n, QS_t and QE, only if the orientation of the layer changed (Dnn, Dnt and inv_Dnn are then invalidated)
+        virtual bool updateD(const arma::mat&, const layer &); //fill Dnn, Dnt and inv_Dnn, only if the orientation of the layer or the tangent modulus (more than precision_lazy_micro) changed. Returns true if they are recomputed
+        virtual void fillA(const arma::mat&, const arma::mat&, const layer &); //fill dXn, dXt and the strain concentration tensor A from the normal and tangent averages m_n, m_t of the stack
+    
         virtual layer_multi& operator = (const layer_multi&);
         
         friend std::ostream& operator << (std::ostream&, const layer_multi&);
@@ -26,6 +26,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <armadillo>
 
 namespace simcoon{
@@ -46,14 +47,17 @@ class phase_multi
 		arma::mat B_start;	//Concentration tensor (stress)
 
         arma::vec A_in;	//Inelastic concentration tensor (strain vector)
+        arma::vec DE_corr;	//Correction of the strain increment w.r.t. A*DE of the last localization, per unit norm of DE (warm start)
+        arma::mat M_in;	//Elastic compliance of the phase, that defines its inelastic strain (transformation field analysis)
+        std::vector<arma::mat> D_in;	//Influence tensors: strain of the phase per unit inelastic strain of each phase (transformation field analysis)
         
 		phase_multi(); 	//default constructor
         phase_multi(const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::vec&); //Constructor with parameters
 		phase_multi(const phase_multi&);	//Copy constructor
         virtual ~phase_multi();
 		
-        void to_start();
-        void set_start();
+        virtual void to_start();
+        virtual void set_start(const int & = 0);
     
 		virtual phase_multi& operator = (const phase_multi&);
 		
@@ -0,0 +1,79 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file voxel_multi.hpp
+///@brief Voxels of a phase of a periodic voxel microstructure, for full-field (FFT-based) homogenization purposes
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <simcoon/Continuum_mechanics/Homogenization/phase_multi.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+
+namespace simcoon{
+
+//======================================
+class voxel_multi : public phase_multi
+//======================================
+{
+	private:
+
+	protected:
+    
+	public :
+    
+        unsigned int n1; //number of voxels of the grid in the direction 1
+        unsigned int n2; //number of voxels of the grid in the direction 2
+        unsigned int n3; //number of voxels of the grid in the direction 3
+        arma::uvec index; //position i + n1*(j + n2*k) of each voxel of the phase in the grid
+        double lambda_0; //Lame coefficients of the isotropic reference medium of the grid
+        double mu_0;
+    
+        //Small-strain fields of the voxels of the phase, one column per voxel in the order of index. The constitutive model of the phase is evaluated voxel by voxel from these fields
+        arma::mat Etot;
+        arma::mat DEtot;
+        arma::mat sigma;
+        arma::mat sigma_start;
+        arma::mat statev;
+        arma::mat statev_start;
+        arma::mat Wm;
+        arma::mat Wm_start;
+        arma::mat Lt; //tangent modulus of each voxel, as a column of 36 components (column-major)
+    
+        voxel_multi(); 	//default constructor
+        voxel_multi(const voxel_multi&);	//Copy constructor
+        ~voxel_multi();
+    
+        unsigned int size() const; //number of voxels of the phase
+        virtual void fill(const state_variables_M &); //all the voxels of index take the state variables of the phase
+        virtual void get(const unsigned int &, state_variables_M &) const; //state variables of the voxel i, at the start of the increment
+        virtual void set(const unsigned int &, const state_variables_M &); //stores the state variables of the voxel i, once its constitutive model is evaluated
+    
+        virtual void to_start(); //also the fields of the voxels
+        virtual void set_start(const int & = 0); //also the fields of the voxels
+    
+        virtual voxel_multi& operator = (const voxel_multi&);
+        
+        friend std::ostream& operator << (std::ostream&, const voxel_multi&);
+    
+};
+
+} //namespace simcoon
@@ -60,6 +60,7 @@ class ODF
 
         void construct(const int&);
         double density(const double &);
+        arma::vec density(const arma::vec &, const bool & = false) const; //densities for a vector of values, split into blocks of nangles_parallel_ODF values evaluated on the thread pool if requested
     
 		virtual ODF& operator = (const ODF&);
     
@@ -32,6 +32,9 @@ namespace simcoon{
 //Fill the ODF from a vector of angles, providing a file with the peak informations
 arma::vec get_densities_ODF(const arma::vec &, const std::string &, const std::string &, const bool &);
     
+//Fill the ODF from a vector of angles, providing an ODF whose peaks are already read (the densities are evaluated on the thread pool if requested)
+arma::vec get_densities_ODF(const arma::vec &, const ODF &, const bool &, const bool & = false);
+    
 //Fill the angles of the geom and material (if indicated 1 in angles_mat)
 void fill_angles(const double &, phase_characteristics &, const ODF &, const int & = 1);
     
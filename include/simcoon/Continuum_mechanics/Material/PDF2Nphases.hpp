@@ -32,6 +32,9 @@ namespace simcoon{
 //Fill the PDF from a vector of parameter, providing a file with the peak informations
 arma::vec get_densities_PDF(const arma::vec &, const std::string &, const std::string &);
     
+//Fill the PDF from a vector of parameter, providing a PDF whose peaks are already read (the densities are evaluated on the thread pool if requested)
+arma::vec get_densities_PDF(const arma::vec &, const PDF &, const bool & = false);
+    
 //Fill the parameters of the geom and material
 void fill_parameters(const double &, phase_characteristics &, const PDF &);
     
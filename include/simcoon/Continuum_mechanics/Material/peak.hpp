@@ -57,6 +57,10 @@ class peak
 
         virtual double get_density_PDF(const double &);
     
+        //Densities for a vector of angles/parameters, evaluated at once for all the values
+        virtual arma::vec get_density_ODF(const arma::vec &) const;
+        virtual arma::vec get_density_PDF(const arma::vec &) const;
+    
 		virtual peak& operator = (const peak&);
     
         friend std::ostream& operator << (std::ostream&, const peak&);
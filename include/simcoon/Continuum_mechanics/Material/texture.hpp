@@ -0,0 +1,72 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file texture.hpp
+///@brief Discretized texture shared by the material points of a polycrystal
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <armadillo>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/material_characteristics.hpp>
+#include <simcoon/Simulation/Geometry/geometry.hpp>
+#include <simcoon/Continuum_mechanics/Material/ODF.hpp>
+
+namespace simcoon{
+
+//======================================
+class texture
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+    
+        int num_phase_disc; //index of the discretized phase in the rve
+        std::string peak_file; //file of the peaks of the ODF (the texture is rebuilt by shared() if it is modified)
+        arma::vec weights; //volume fraction of each orientation in the rve
+    
+        phase_characteristics grain; //discretized phase, whose state variables and concentration tensors initialize the orientations
+        std::vector<std::shared_ptr<material_characteristics> > matprops; //material properties of each orientation, shared by all the material points
+        std::vector<std::shared_ptr<geometry> > shapes; //geometry of each orientation, shared by all the material points
+    
+        texture(); 	//default constructor
+        texture(const phase_characteristics &, const int &, ODF &, const int &, const int & = 1); //discretization of the phase of an rve with an ODF (as discretize_ODF)
+        texture(const texture&);	//Copy constructor
+        virtual ~texture();
+    
+        unsigned int size() const; //number of orientations
+    
+        //Replace the discretized phase of an rve by the orientations: the material properties and the geometry are shared, only the state variables and the concentration tensors are allocated
+        void build(phase_characteristics &) const;
+    
+        //Texture described in the file (in path_data) for the rve whose phases are read, built once and shared (thread-safe); null if the file does not exist
+        static std::shared_ptr<const texture> shared(const phase_characteristics &, const std::string &, const std::string &);
+    
+        virtual texture& operator = (const texture&);
+    
+        friend std::ostream& operator << (std::ostream&, const texture&);
+};
+
+} //namespace simcoon
@@ -0,0 +1,72 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file L_eff_table.hpp
+///@brief Tabulated effective stiffness of a microstructure of ellipsoidal phases over a grid of parameters, evaluated by multilinear interpolation
+///@version 1.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <armadillo>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+
+namespace simcoon{
+
+//======================================
+class L_eff_table
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+    
+        arma::umat parameters; //phase number and parameter of each axis of the grid (0 : c, 1 : a1, 2 : a2, 3 : a3, 10+j : props(j) of the phase)
+        std::vector<arma::vec> axes; //increasing values of the parameter of each axis
+        arma::mat table; //components (column-major) of the effective stiffness at each node of the grid (36 x number of nodes, the first axis varies first)
+        arma::vec error; //relative errors (maximum, root mean square) of the interpolation at the centers of random cells of the grid
+    
+        L_eff_table(); 	//default constructor
+        L_eff_table(const arma::umat &, const std::vector<arma::vec> &); //Constructor with the axes of the grid
+        L_eff_table(const L_eff_table&);	//Copy constructor
+        virtual ~L_eff_table();
+    
+        unsigned int size() const; //number of nodes of the grid
+        arma::uvec node(const unsigned int &) const; //indices along each axis of a node of the grid
+    
+        //Fill the table with the scheme of the rve (MIHEN, MIMTN or MISCN), once its phases are read and their elastic stiffness computed (get_L_elastic). The error is estimated on a number of random cells
+        void build(const phase_characteristics &, const unsigned int & = 0);
+        arma::mat interpolate(const arma::vec &) const; //effective stiffness at a point of the parameter space (clamped to the grid)
+    
+        bool save(const std::string &) const; //binary file
+        bool load(const std::string &);
+    
+        static std::shared_ptr<const L_eff_table> shared(const std::string &); //table loaded once per file and shared (thread-safe); null if the file cannot be read
+    
+        virtual L_eff_table& operator = (const L_eff_table&);
+    
+        friend std::ostream& operator << (std::ostream&, const L_eff_table&);
+};
+
+//Effective stiffness of the microstructure of the rve for points of the parameter space of the table (one column per point), with its scheme
+std::vector<arma::mat> L_eff_variants(const phase_characteristics &, const arma::umat &, const arma::mat &);
+
+} //namespace simcoon
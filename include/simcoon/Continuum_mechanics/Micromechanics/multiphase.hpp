@@ -22,6 +22,7 @@
 #pragma once
 
 #include <armadillo>
+#include <simcoon/parameter.hpp>
 #include <simcoon/Simulation/Phase/phase_characteristics.hpp>
 
 namespace simcoon{
@@ -31,7 +32,35 @@ namespace simcoon{
 ///@brief props[1] : Number of the file NPhase[i].dat utilized
 ///@brief props[2] : Number of integration points in the 1 direction
 ///@brief props[3] : Number of integration points in the 2 direction
+///@brief With texture, if the file Ntexture[i].dat exists, one of the phases is discretized into orientations with an ODF, built once and shared by all the material points (the phases that follow it are renumbered). The file is looked up once per material point
+///@brief With warm_start, the localization starts from the concentration tensors of the last call. Returns the number of passes of the localization
 
-void umat_multi(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, bool &, const unsigned int &, double &, const int &);
+int umat_multi(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, bool &, const unsigned int &, double &, const int &, const bool & = warm_start_micro, const bool & = texture_micro);
+
+// The reduced-order (transformation field analysis) multiphase UMAT, based on the Mori-Tanaka scheme, works with the following material properties
+///@brief props[0] : Number of phases
+///@brief props[1] : Number of the file Nellipsoids[i].dat utilized
+///@brief props[2] : Number of integration points in the 1 direction
+///@brief props[3] : Number of integration points in the 2 direction
+///@brief props[4] : Number of the matrix phase
+///@brief The concentration and influence tensors are computed once from the elastic stiffnesses of the phases
+
+void umat_multi_TFA(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, bool &, const unsigned int &, double &);
+
+// The full-field (FFT-based) multiphase UMAT over a periodic voxel grid works with the following material properties
+///@brief props[0] : Number of phases
+///@brief props[1] : Number of the files Nphases[i].dat (phases) and Nvoxels[i].dat (voxel grid) utilized
+///@brief props[2] : Scheme (0 : basic scheme of Moulinec-Suquet, 1 : accelerated by Anderson mixing)
+///@brief props[3] : Effective tangent modulus (0 : average of the tangent moduli of the voxels, 1 : solution of the linearized full-field problems)
+
+void umat_multi_FFT(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, bool &, const unsigned int &, double &);
+
+// The surrogate multiphase UMAT, whose effective stiffness is interpolated in a table computed beforehand (L_eff_table), works with the following material properties
+///@brief props[0] : Number of the file L_eff_table[i].bin utilized
+///@brief props[1...] : Values of the parameters of the axes of the table
+///@brief The material is linear elastic
+///@brief A std::runtime_error is thrown if the table cannot be read
+
+void umat_multi_table(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, bool &, const unsigned int &, double &);
 
 } //namespace simcoon
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <vector>
 #include <armadillo>
 #include <simcoon/Simulation//Phase/phase_characteristics.hpp>
 
@@ -39,11 +40,17 @@ void DE_Homogeneous_E(phase_characteristics &);
 void Lt_Mori_Tanaka(phase_characteristics &, const int &);
 void DE_Mori_Tanaka(phase_characteristics &, const int &);
     
+//Elastic strain concentration tensors A and influence tensors D_in of the Mori-Tanaka scheme, for the elastic stiffnesses of the phases (transformation field analysis)
+void TFA_Mori_Tanaka(phase_characteristics &, const int &, const std::vector<arma::mat> &);
+    
 void Lt_Mori_Tanaka_iso(phase_characteristics &, const int &);
 void DE_Mori_Tanaka_iso(phase_characteristics &, const int &);
     
 void Lt_Self_Consistent(phase_characteristics &, const int &, const bool &, const int & = 1);
 void DE_Self_Consistent(phase_characteristics &, const int &, const bool &, const int & = 1);
+
+//Self-consistent effective tangent modulus solved with a Broyden quasi-Newton method on its 21 independent components, warm-started (optionally) from the current effective tangent modulus. Returns the number of evaluations of the concentration tensors
+int Lt_Self_Consistent_Broyden(phase_characteristics &, const int &, const bool &, const int & = 1, const bool & = true);
     
 void Lt_Periodic_Layer(phase_characteristics &);
 void dE_Periodic_Layer(phase_characteristics &, const int &);
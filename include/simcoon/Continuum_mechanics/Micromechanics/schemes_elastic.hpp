@@ -0,0 +1,54 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+///@file schemes_elastic.hpp
+///@brief micromechanical schemes for linear elastic N-phases heterogeneous materials:
+///@brief the effective stiffness is computed directly from the stiffness, shape and volume fraction of the phases, without state variables nor input files
+///@version 1.0
+
+#pragma once
+
+#include <vector>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
+#include <simcoon/Simulation/Geometry/layer.hpp>
+
+namespace simcoon{
+
+//Note All the stiffness tensors are expressed in the coordinate system of the RVE. The integration directions xi, w of the Eshelby tensors are computed once with the function directions (eshelby.hpp) and reused for all the calls
+
+//Interaction tensor T of an ellipsoidal phase of stiffness L embedded in a reference medium of stiffness L_0. If analytical is true, the closed-form Eshelby tensors are used when the reference medium is isotropic and the ellipsoid is a spheroid
+arma::mat T_elastic(const arma::mat &, const arma::mat &, const ellipsoid &, const arma::mat &, const arma::vec &, const bool & = analytical_eshelby);
+
+//Effective stiffness for a homogeneous strain (Voigt) assumption, from the stiffness and the volume fraction of the phases
+arma::mat L_eff_Homogeneous_E(const std::vector<arma::mat> &, const arma::vec &);
+
+//Effective stiffness of ellipsoidal phases with the Mori-Tanaka scheme. The reference medium is the phase n_matrix (index in the vectors)
+arma::mat L_eff_Mori_Tanaka(const std::vector<arma::mat> &, const std::vector<ellipsoid> &, const int &, const arma::mat &, const arma::vec &, const bool & = analytical_eshelby);
+
+//Effective stiffness of ellipsoidal phases with the self-consistent scheme, started from the Mori-Tanaka estimate (or the Voigt one if n_matrix < 0)
+arma::mat L_eff_Self_Consistent(const std::vector<arma::mat> &, const std::vector<ellipsoid> &, const int &, const arma::mat &, const arma::vec &, const bool & = analytical_eshelby);
+
+//Effective stiffness of a periodic stack of layers
+arma::mat L_eff_Periodic_Layer(const std::vector<arma::mat> &, const std::vector<layer> &);
+
+//Effective stiffness of a batch of variants of a microstructure of ellipsoidal phases (stiffness and shape of the phases for each variant), with the scheme method (100 : MIHEN, 101 : MIMTN, 103 : MISCN). The variants are evaluated in parallel
+std::vector<arma::mat> L_eff_batch(const std::vector<std::vector<arma::mat> > &, const std::vector<std::vector<ellipsoid> > &, const int &, const int &, const arma::mat &, const arma::vec &, const bool & = analytical_eshelby);
+
+} //namespace simcoon
@@ -0,0 +1,45 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file schemes_fft.hpp
+///@brief FFT-based full-field homogenization of periodic voxel microstructures (Moulinec-Suquet scheme)
+///@version 1.0
+
+#pragma once
+
+#include <vector>
+#include <armadillo>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+
+namespace simcoon{
+
+//In-place 3D discrete Fourier transform (or its inverse, normalized) of each column of a field over a n1 x n2 x n3 grid, stored in the order i + n1*(j + n2*k)
+void fft_3D(arma::cx_mat &, const unsigned int &, const unsigned int &, const unsigned int &, const bool & = false);
+
+//In-place application of the periodic Green operator of the isotropic reference medium (lambda_0, mu_0) to the Fourier transform of a stress field (Voigt notation, the result is a strain field)
+void Gamma_0_fft(arma::cx_mat &, const unsigned int &, const unsigned int &, const unsigned int &, const double &, const double &);
+
+//Lame coefficients (lambda_0, mu_0) of the isotropic reference medium, the averages of the extreme values of the isotropic parts of the stiffnesses
+void reference_medium_fft(double &, double &, const std::vector<arma::mat> &);
+
+//Strain increments of the voxels of the phase that satisfy the compatibility and the equilibrium (scheme 0 : basic scheme of Moulinec-Suquet, 1 : accelerated by Anderson mixing). The constitutive models of the voxels are evaluated. Returns the number of iterations
+int DE_FFT(phase_characteristics &, const arma::mat &, const double &, const double &, const int &, const int &, bool &, const unsigned int &, double &, const int &);
+
+//Effective tangent modulus, from the six full-field problems linearized with the tangent moduli of the voxels
+arma::mat Lt_FFT(phase_characteristics &, const int &);
+    
+} //namespace simcoon
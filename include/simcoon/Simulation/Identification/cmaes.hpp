@@ -0,0 +1,82 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file cmaes.hpp
+///@brief Covariance matrix adaptation evolution strategy (CMA-ES) with restarts, to generate the individuals of the identification
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include "parameters.hpp"
+#include "generation.hpp"
+
+namespace simcoon{
+
+//======================================
+class cmaes
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+    
+        int n;              //Number of parameters
+        int lambda;         //Number of individuals sampled at each generation
+        int mu;             //Number of individuals selected to update the distribution
+        arma::vec weights;  //Recombination weights
+        double mueff;       //Variance effective selection mass
+        double cc, cs, c1, cmu, damps, chiN;    //Learning rates, damping and expectation of ||N(0,I)||
+    
+        arma::vec min_values;   //The parameters are normalized by their bounds
+        arma::vec ranges;
+    
+        arma::vec m;        //Mean of the distribution (normalized parameters)
+        double sigma;       //Step size
+        double sigma0;      //Initial step size (at each restart)
+        arma::mat C;        //Covariance matrix
+        arma::mat B;        //Eigenvectors of C
+        arma::vec D;        //Square roots of the eigenvalues of C
+        arma::vec pc;       //Evolution path of C
+        arma::vec ps;       //Evolution path of sigma
+    
+        int ngen;           //Number of generations since the last restart
+        int restarts;       //Number of restarts
+        double best_cost;   //Best cost since the last restart
+        int stagnation;     //Number of generations without improvement of the best cost
+    
+		cmaes(); 	//default constructor
+		cmaes(const std::vector<parameters> &, const int &, const arma::vec &, const double & = sigma_cmaes);	//Constructor with the parameters, the number of individuals per generation, the initial mean and step size
+		cmaes(const cmaes &);	//Copy constructor
+		~cmaes();
+    
+        void sample(generation &, int &) const;     //Sample the individuals of a generation (new ids)
+        void update(const generation &);            //Update the distribution from the evaluated individuals sampled
+        bool stop() const;                          //Check if the distribution has converged, degenerated or stagnates
+        void restart(const arma::vec &);            //Restart from a new mean (normalized parameters)
+				
+		virtual cmaes& operator = (const cmaes&);
+		
+        friend  std::ostream& operator << (std::ostream&, const cmaes&);
+};
+
+} //namespace simcoon
@@ -0,0 +1,71 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file eval_cache.hpp
+///@brief Cache of the numerical vectors of the parameter sets already evaluated during an identification
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include "parameters.hpp"
+#include "constants.hpp"
+
+namespace simcoon{
+
+//======================================
+class eval_cache
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+    
+        double quantum;                 //Quantization step of the parameters, relative to their range
+        arma::vec min_values;           //Minimal values of the parameters
+        arma::vec ranges;               //Ranges of the parameters
+        unsigned long long signature;   //Signature of the problem (input files, parameters, size of the numerical vector)
+        std::map<std::vector<double>, arma::vec> vnums; //Numerical vectors of the quantized parameter sets
+        unsigned int hits;              //Number of evaluations found in the cache
+    
+		eval_cache(); 	//default constructor
+		eval_cache(const std::vector<parameters> &, const std::vector<constants> &, const std::string &, const std::string &, const int &, const double & = quantum_cache_identification);	//Constructor from the parameters, constants, the folders of the keys and of the data, and the size of the numerical vector
+		eval_cache(const eval_cache &);	//Copy constructor
+		~eval_cache();
+		
+		unsigned int size() const {return vnums.size();}  // returns the number of parameter sets in the cache
+    
+        std::vector<double> key(const arma::vec &) const;    //Quantized parameter set
+        bool find(const arma::vec &, arma::vec &);          //Numerical vector of a parameter set, if it was already evaluated
+        void insert(const arma::vec &, const arma::vec &);  //Add the numerical vector of a parameter set
+    
+        bool save(const std::string &) const;
+        bool load(const std::string &);     //Read a cache saved for the same signature (the current entries are kept otherwise)
+				
+		virtual eval_cache& operator = (const eval_cache&);
+		
+        friend  std::ostream& operator << (std::ostream&, const eval_cache&);
+};
+
+} //namespace simcoon
@@ -29,6 +29,7 @@
 
 namespace simcoon{
     
-void run_identification(const std::string &, const int &, const int &, const int &, const int &, const int &, int &, int &, const int &, const int &, const int & = 6, const double & = 1.E-12, const std::string & = "data/", const std::string & = "keys/", const std::string & = "results/", const std::string & = "material.dat", const std::string & = "id_params.txt", const std::string & = "simul.txt", const double & = 5, const double & = 0.01, const double & = 0.001, const double & = 10, const double & = 0.01);
+//The last argument selects the method that generates the individuals : GA (genetic algorithm), SSGA (asynchronous steady-state genetic algorithm), DE (differential evolution) or CMAES (CMA-ES with restarts)
+void run_identification(const std::string &, const int &, const int &, const int &, const int &, const int &, int &, int &, const int &, const int &, const int & = 6, const double & = 1.E-12, const std::string & = "data/", const std::string & = "keys/", const std::string & = "results/", const std::string & = "material.dat", const std::string & = "id_params.txt", const std::string & = "simul.txt", const double & = 5, const double & = 0.01, const double & = 0.001, const double & = 10, const double & = 0.01, const std::string & = "GA");
 
 } //namespace simcoon
@@ -0,0 +1,69 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file key_template.hpp
+///@brief Input files of the identification, parsed once with the slots of the keys of parameters and constants
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include "parameters.hpp"
+#include "constants.hpp"
+
+namespace simcoon{
+
+//======================================
+class key_template
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+    
+        std::string file;                   //Name of the template file
+        std::vector<std::string> tokens;    //Text between the keys (size() + 1 tokens)
+        std::vector<std::string> slots;     //Key found between tokens[i] and tokens[i+1]
+    
+		key_template(); 	//default constructor
+		key_template(const std::string &, const std::string &, const std::vector<std::string> &);	//Constructor from the file (path, name) and the keys to find
+		key_template(const key_template &);	//Copy constructor
+		~key_template();
+		
+		unsigned int size() const {return slots.size();}  // returns the number of keys found in the file
+    
+        std::string apply(const std::map<std::string, std::string> &) const;   //Text of the file, the keys being replaced by their values
+        void write(const std::string &, const std::map<std::string, std::string> &) const;  //Write the text of the file in a folder, the keys being replaced by their values
+    
+        //Template of the file (path, name) shared between the evaluations, parsed again only if the file or the keys have changed
+        static std::shared_ptr<const key_template> shared(const std::string &, const std::string &, const std::vector<std::string> &);
+				
+		virtual key_template& operator = (const key_template&);
+		
+        friend  std::ostream& operator << (std::ostream&, const key_template&);
+};
+    
+//Values of the keys of the parameters and constants, written as the identification always did (std::to_string)
+std::map<std::string, std::string> key_values(const std::vector<parameters> &, const std::vector<constants> &);
+
+} //namespace simcoon
@@ -22,14 +22,25 @@
 
 #pragma once
 #include <fstream>
+#include <functional>
 #include <armadillo>
 #include "generation.hpp"
 
 namespace simcoon{
     
+//Breed an individual from two random parents among the first individuals of a generation (crossover, perturbation and mutation of the genetic method)
+void breed(const generation &, individual &, const int &, const double &, const double &, const std::vector<parameters> &);
+    
 //Genetic method
 void genetic(generation &, generation &, int &, const double &, const double &, const std::vector<parameters> &);
 
+//Differential evolution (DE/rand/1/bin), with the differential weight F and the crossover probability CR
+void differential_evolution(const generation &, generation &, int &, const double &, const double &, const std::vector<parameters> &);
+
+//Steady-state genetic method : each of the nworkers breeds an individual from the population as soon as it is free, evaluates its cost (function of the individual and of the worker), and inserts it in the population in place of the worst one if better
+//The individuals evaluated are given in gensons, whose size sets the number of evaluations; the population (classified) is updated
+void steady_state(generation &, generation &, int &, const double &, const double &, const std::vector<parameters> &, const unsigned int &, const std::function<double(const individual &, const unsigned int &)> &);
+
 ///Genrun creation
 void to_run(generation &, generation &, generation &, const double &, const std::vector<parameters> &);
 
@@ -37,6 +48,10 @@ void to_run(generation &, generation &, generation &, const double &, const std:
 //Define the new gen_cur and gboys_cur accordingly
 void find_best(generation &, generation &, const generation &, const generation &, const generation &, const int &, const int &, int &);
 
+//Selection of the differential evolution : each trial individual of the gensons replaces its target of the previous generation (or gboys) if it is not worse
+//Define the new gen_cur and gboys_cur accordingly
+void select_trials(generation &, generation &, const generation &, const generation &, const generation &, const int &, const int &, int &);
+
 //Write the results in an output file
 void write_results(std::ofstream &, const std::string &outputfile, const generation &, const int &, const int &, const int &);
 
@@ -47,6 +47,9 @@ void ident_essentials(int &, int &, int &, const std::string &, const std::strin
 //Read the control parameters of the optimization algorithm
 void ident_control(int &, int &, int &, int &, int &, int &, int &, double &, double &, double &, double &, double &, double &, const std::string &, const std::string &);
 
+//Same, with the optimization method (optional last entry Method : GA, SSGA, DE or CMAES)
+void ident_control(int &, int &, int &, int &, int &, int &, int &, double &, double &, double &, double &, double &, double &, std::string &, const std::string &, const std::string &);
+
 void read_gen(int &, arma::mat &, const int &);
     
 } //namespace simcoon
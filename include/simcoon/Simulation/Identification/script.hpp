@@ -22,12 +22,16 @@
 #pragma once
 
 #include <iostream>
+#include <map>
+#include <functional>
 #include <armadillo>
+#include <simcoon/parameter.hpp>
 #include "constants.hpp"
 #include "parameters.hpp"
 #include "opti_data.hpp"
 #include "individual.hpp"
 #include "generation.hpp"
+#include "eval_cache.hpp"
 
 namespace simcoon{
 
@@ -43,8 +47,17 @@ void apply_parameters(const std::vector<parameters> &, const std::string &);
 //This function will replace the keys by the parameters
 void apply_constants(const std::vector<constants> &, const std::string &);
     
-//Read the control parameters of the optimization algorithm
-void launch_solver(const generation &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
+//Text of the files of the parameters and constants (parsed once in path_keys), the keys being replaced by their current values
+std::map<std::string, std::string> key_files(const std::vector<parameters> &, const std::vector<constants> &, const std::string &);
+
+//Write the files with keys replaced in a folder, except the files handled in memory (always written if write_keys_identification is true)
+void write_key_files(const std::map<std::string, std::string> &, const std::string &, const std::vector<std::string> & = {});
+    
+//Run the solver for each test of an individual, the results being written in files
+void launch_solver(const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
+
+//Run the solver for each test of an individual, the selected columns of the results being written by the solver directly in the numerical data (no result file)
+void launch_solver(const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
     
 //Read the control parameters of the optimization algorithm
 void launch_odf(const generation &, std::vector<parameters> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
@@ -52,11 +65,40 @@ void launch_odf(const generation &, std::vector<parameters> &, const std::string
 //Read the control parameters of the optimization algorithm
     void launch_func_N(const generation &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
     
-void run_simulation(const std::string &, const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
+//Run the simulations of an individual and get the numerical data, from the result files or in memory (SOLVE only) if in_memory is true
+void run_simulation(const std::string &, const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&, const bool & = false);
     
 double calc_cost(const arma::vec &, arma::vec &, const arma::vec &, const std::vector<opti_data> &, const std::vector<opti_data> &, const int &, const int &);
 
-arma::mat calc_sensi(const individual &, generation &, const std::string &, const int &, const int &, std::vector<parameters> &, std::vector<constants> &, arma::vec &, std::vector<opti_data> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const int &, const arma::vec &, const std::string&);
+//Private copy of a folder used by the worker k (path_w<k>)
+std::string worker_path(const std::string &, const unsigned int &);
+
+//Create the private data (copy of path_data) and numerical results folders of nworkers workers
+void setup_workers(const unsigned int &, const std::string &, const std::string &);
+
+//Remove the private folders of the workers
+void clean_workers(const unsigned int &, const std::string &, const std::string &);
+
+//Evaluate each individual of a generation with a function of the individual, its results and data folders and its worker, concurrently over nworkers private working directories (sequentially in the folders themselves if nworkers < 2)
+void run_individuals(const generation &, const std::string &, const std::string &, const unsigned int &, std::vector<arma::vec> &, const std::function<arma::vec(const individual &, const std::string &, const std::string &, const unsigned int &)> &);
+
+//Run the simulations of each individual of a generation and get their numerical vectors, concurrently over nworkers private working directories (sequentially in the folders themselves if nworkers < 2)
+void run_individuals(const std::string &, const generation &, const int &, const std::vector<parameters> &, const std::vector<constants> &, const std::vector<opti_data> &, const std::vector<opti_data> &, const int &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, const unsigned int &, std::vector<arma::vec> &);
+
+//Same, the parameter sets already evaluated (in the cache or earlier in the generation) being not run again. The new evaluations are added to the cache
+void run_individuals(const std::string &, const generation &, const int &, const std::vector<parameters> &, const std::vector<constants> &, const std::vector<opti_data> &, const std::vector<opti_data> &, const int &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, const unsigned int &, std::vector<arma::vec> &, eval_cache &);
+    
+//Run the simulations (unless found in the cache) and compute the cost function of each individual of a generation, concurrently over nworkers private working directories
+void run_generation(const std::string &, generation &, const int &, const std::vector<parameters> &, const std::vector<constants> &, const std::vector<opti_data> &, const std::vector<opti_data> &, const arma::vec &, const arma::vec &, const int &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, eval_cache &, const unsigned int & = 1);
+
+//Asynchronous steady-state genetic algorithm: as soon as one of the nworkers is free, it breeds a new individual from the current population (genetic operators), evaluates it and inserts it in the population in place of the worst one if better. The individuals evaluated are given in the second generation, whose size sets the number of evaluations
+void run_steady_state(const std::string &, const generation &, generation &, int &, const double &, const double &, const int &, const std::vector<parameters> &, const std::vector<constants> &, const std::vector<opti_data> &, const std::vector<opti_data> &, const arma::vec &, const arma::vec &, const int &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, eval_cache &, const unsigned int & = 1);
+
+//Compute the sensitivity matrix of an individual (finite differences, forward or central), the perturbed individuals being evaluated by a function of a generation that gives their numerical vectors. The perturbations are given back, to be adapted at the next call if adaptive_sensi_identification is true
+arma::mat calc_sensi(const individual &, const std::vector<parameters> &, arma::vec &, const arma::vec &, arma::vec &, const std::function<void(const generation &, std::vector<arma::vec> &)> &, const bool & = central_sensi_identification);
+
+//Compute the sensitivity matrix of an individual (finite differences, forward or central), the perturbed simulations being evaluated (unless found in the cache) concurrently over nworkers private working directories. The perturbations are given back, to be adapted at the next call if adaptive_sensi_identification is true
+arma::mat calc_sensi(const individual &, const std::string &, const int &, const int &, const std::vector<parameters> &, const std::vector<constants> &, arma::vec &, const std::vector<opti_data> &, const std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const int &, const arma::vec &, arma::vec &, const std::string&, eval_cache &, const unsigned int & = 1);
 
     
 } //namespace simcoon
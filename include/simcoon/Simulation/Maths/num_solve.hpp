@@ -29,5 +29,8 @@ void Fischer_Burmeister_m(const arma::vec &, const arma::vec &, const arma::mat
 void Fischer_Burmeister_m_limits(const arma::vec &, const arma::vec &, const arma::vec &, const arma::mat &, const arma::mat &, arma::vec &, arma::vec &, double &);
     
 arma::mat denom_FB_m(const arma::vec &, const arma::mat &, const arma::vec &);
+
+//Anderson (type-II) mixing for a fixed-point iteration x = g(x): returns the next iterate from x and g(x), and updates the history (differences of g and of the residuals f = g - x, limited to depth columns). If the least-squares problem fails, the history is cleared and g(x) is returned
+arma::vec Anderson_mixing(const arma::vec &, const arma::vec &, arma::mat &, arma::mat &, arma::vec &, arma::vec &, const unsigned int &);
     
 } //namespace simcoon
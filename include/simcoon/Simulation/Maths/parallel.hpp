@@ -0,0 +1,79 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file parallel.hpp
+///@brief Thread pool utilized to distribute independent evaluations (phases, individuals...)
+///@version 1.0
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+namespace simcoon{
+
+//======================================
+class thread_pool
+//======================================
+{
+	private:
+    
+        std::vector<std::thread> workers;
+        std::mutex mtx;
+        std::mutex run_mtx;
+        std::condition_variable cv_work;
+        std::condition_variable cv_done;
+    
+        const std::function<void(const unsigned int &)> *job;
+        unsigned int job_size;
+        std::atomic<unsigned int> job_next;
+        unsigned int active;
+        unsigned long generation;
+        bool stop;
+        std::exception_ptr error;
+    
+        void work();
+        void run_job();
+
+	protected:
+
+	public :
+    
+        thread_pool(const unsigned int & = 0); //Constructor with the number of threads (0 : hardware concurrency)
+        ~thread_pool();
+    
+        thread_pool(const thread_pool &) = delete;
+        thread_pool& operator = (const thread_pool &) = delete;
+    
+        unsigned int size() const; //Number of threads, including the calling thread
+    
+        //Run f(i) for i in [0, n[ over the threads; the first exception thrown is rethrown in the calling thread.
+        //Calls from inside a running loop (nested loops) are run sequentially in the calling thread
+        void parallel_for(const unsigned int &, const std::function<void(const unsigned int &)> &);
+};
+    
+//Shared thread pool of the library, built on first use
+thread_pool& default_thread_pool();
+
+//Run f(i) for i in [0, n[ on the shared thread pool
+void parallel_for(const unsigned int &, const std::function<void(const unsigned int &)> &);
+
+} //namespace simcoon
@@ -55,4 +55,12 @@ double PseudoVoigt(const double &, const double &, const double &, const double
 ///6. Pearson VII
 double Pearson7(const double &, const double &, const double &, arma::vec &);
 
+//Vectorized versions of the density functions, evaluated for each value of a vector
+arma::vec ODF_sd(const arma::vec &, const double &, const arma::vec &);
+arma::vec ODF_hard(const arma::vec &, const double &, const double &, const double &);
+arma::vec Gaussian(const arma::vec &, const double &, const double &, const double & = 1.);
+arma::vec Lorentzian(const arma::vec &, const double &, const double &, const double & = 1.);
+arma::vec PseudoVoigt(const arma::vec &, const double &, const double &, const double &, const double &, const arma::vec & = arma::ones(1));
+arma::vec Pearson7(const arma::vec &, const double &, const double &, const arma::vec &);
+
 } //namespace simcoon
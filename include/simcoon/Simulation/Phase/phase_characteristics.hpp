@@ -31,9 +31,13 @@
 #include <simcoon/Simulation/Phase/state_variables.hpp>
 #include <simcoon/Simulation/Solver/output.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/phase_multi.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/layer_multi.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/ellipsoid_multi.hpp>
 
 namespace simcoon{
 
+class texture;
+
 //======================================
 class phase_characteristics
 //======================================
@@ -51,8 +55,18 @@ class phase_characteristics
         std::shared_ptr<material_characteristics> sptr_matprops;
         std::shared_ptr<state_variables> sptr_sv_global;
         std::shared_ptr<state_variables> sptr_sv_local;
-        std::shared_ptr<std::ofstream> sptr_out_global;
-        std::shared_ptr<std::ofstream> sptr_out_local;
+        std::shared_ptr<std::ostream> sptr_out_global; //Output of the results (files defined by define_output, or any stream)
+        std::shared_ptr<std::ostream> sptr_out_local;
+    
+        //Typed views of sptr_shape and sptr_multi, cast once when the phase is built (nullptr if the shape_type does not match)
+        std::shared_ptr<layer> sptr_layer;
+        std::shared_ptr<layer_multi> sptr_layer_multi;
+        std::shared_ptr<ellipsoid> sptr_ellipsoid;
+        std::shared_ptr<ellipsoid_multi> sptr_ellipsoid_multi;
+    
+        //Texture of the material point (umat_multi), looked up once: texture_read is set after the lookup, sptr_texture is null if there is no texture
+        std::shared_ptr<const texture> sptr_texture;
+        bool texture_read;
     
         std::vector<phase_characteristics> sub_phases;
         std::string sub_phases_file;
@@ -62,6 +76,7 @@ class phase_characteristics
         phase_characteristics(const int &, const int &, const std::shared_ptr<geometry> &, const std::shared_ptr<phase_multi> &, const std::shared_ptr<material_characteristics> &, const std::shared_ptr<state_variables> &, const std::shared_ptr<state_variables> &, const std::shared_ptr<std::ofstream> &, const std::shared_ptr<std::ofstream> &, const std::string &);
 
 		phase_characteristics(const phase_characteristics&);	//Copy constructor
+        phase_characteristics(phase_characteristics&&) noexcept;	//Move constructor
         virtual ~phase_characteristics();
     
         virtual void construct(const int &, const int &);
@@ -71,10 +86,13 @@ class phase_characteristics
         virtual void local2global();
         virtual void global2local();
         virtual void copy(const phase_characteristics&);   //Be warned that the ofstreams are NOT copied
+        virtual void set_typed_views();   //To call whenever sptr_shape or sptr_multi is replaced
 
 		virtual phase_characteristics& operator = (const phase_characteristics&);
+        virtual phase_characteristics& operator = (phase_characteristics&&) noexcept;
     
         virtual void define_output(const std::string &, const std::string & = "results", const std::string & = "global");
+        virtual void define_output_stream(const std::shared_ptr<std::ostream> &, const std::string & = "global"); //The results of the phase are written in the stream, those of its sub-phases are discarded
         virtual void output(const solver_output &, const int &, const int &, const int &, const int &, const double &, const std::string & = "global");
     
     
@@ -41,4 +41,7 @@ void read_ellipsoid(phase_characteristics &, const std::string & = "data", const
 /// Function that reads the characteristics of a cylinder
 void read_cylinder(phase_characteristics &, const std::string & = "data", const std::string & = "Ncylinders0.dat");
 
+/// Function that reads the voxel grid of a periodic microstructure (the phase of each voxel), once its phases are read
+void read_voxels(phase_characteristics &, const std::string & = "data", const std::string & = "Nvoxels0.dat");
+
 } //namespace simcoon
\ No newline at end of file
@@ -0,0 +1,68 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file column_buffer.hpp
+///@brief Stream buffer that keeps selected columns of the results written by the solver in memory
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <armadillo>
+
+namespace simcoon{
+
+//======================================
+class column_buffer : public std::streambuf
+//======================================
+{
+	private:
+    
+        std::string token;          //Current token
+        unsigned int ncol;          //Index of the current column in the line
+        int nline;                  //Number of non-empty lines already read
+        bool empty_line;
+        std::vector<double> row;    //Selected values of the current line
+        std::vector<double> values; //Selected values of the lines read (row-wise)
+    
+        void end_token();
+        void end_line();
+
+	protected:
+    
+        virtual int_type overflow(int_type);
+        virtual std::streamsize xsputn(const char *, std::streamsize);
+
+	public :
+    
+        arma::Col<int> columns;     //Columns to keep (0 : first column of a line)
+        int skiplines;              //Number of non-empty lines to skip (header)
+    
+        column_buffer(const arma::Col<int> &, const int & = 0);	//Constructor with the columns to keep and the number of lines to skip
+        virtual ~column_buffer();
+    
+        column_buffer(const column_buffer &) = delete;
+        column_buffer& operator = (const column_buffer &) = delete;
+    
+        unsigned int size() const {return (columns.n_elem > 0) ? values.size()/columns.n_elem : 0;}   //Number of lines kept
+        arma::mat data();   //Values kept (one row per line, one column per selected column)
+};
+
+} //namespace simcoon
@@ -22,6 +22,7 @@
 #pragma once
 #include <armadillo>
 #include <string>
+#include <istream>
 #include "block.hpp"
 #include "output.hpp"
 
@@ -43,6 +44,9 @@ void solver_control(double &, double &, int &, int &, int &, double &, double &,
     
 /// Function that reads the material properties
 void read_matprops(std::string &, unsigned int &, arma::vec &, unsigned int &, double &, double &, double &, const std::string & = "data", const std::string & = "material.dat");
+
+/// Function that reads the material properties from a stream (material definition in memory)
+void read_matprops(std::string &, unsigned int &, arma::vec &, unsigned int &, double &, double &, double &, std::istream &);
     
 /// Function that reads the output parameters
 void read_output(solver_output &, const int &, const int &, const std::string & = "data", const std::string & = "output.dat");
@@ -53,4 +57,7 @@ void check_path_output(const std::vector<block> &, const solver_output &);
 /// Function that reads the loading path
 void read_path(std::vector<block> &, double &, const std::string & = "data", const std::string & = "path.txt");
 
+/// Function that reads the loading path from a stream (path definition in memory), the files of the user-input steps being in the folder path_data
+void read_path(std::vector<block> &, double &, std::istream &, const std::string & = "data");
+
 } //namespace simcoon
@@ -22,10 +22,18 @@
 #pragma once
 #include <armadillo>
 #include <string>
+#include <vector>
+#include <memory>
+#include <iostream>
+#include "block.hpp"
 
 namespace simcoon{
 
 //function that solves a
 void solver(const std::string &, const arma::vec &, const unsigned int &, const double &, const double &, const double &, const int &, const int &, const double & = 0.5, const double & = 2., const int & = 10, const int & = 100, const int & = 1, const double & = 1.E-6, const double & = 10000., const std::string& = "data", const std::string& = "results", const std::string& = "path.txt", const std::string& = "result_job.txt");
 
+//function that solves a homogeneous problem along loading blocks already defined (the path definition being in memory), from the initial temperature T_init
+//If a stream is provided, the global results of the rve are written in it instead of the result files (no local results)
+void solver(const std::string &, const arma::vec &, const unsigned int &, const double &, const double &, const double &, const int &, const int &, const double &, const double &, const int &, const int &, const int &, const double &, const double &, std::vector<block> &, const double &, const std::string& = "data", const std::string& = "results", const std::string& = "result_job.txt", const std::shared_ptr<std::ostream> & = std::shared_ptr<std::ostream>());
+
 } //namespace simcoon
@@ -80,4 +80,120 @@ namespace simcoon{
 #define precision_micro 1E-6
 #endif
 
+#ifndef nphases_parallel_micro
+#define nphases_parallel_micro 64
+#endif
+
+#ifndef depth_anderson_micro
+#define depth_anderson_micro 0
+#endif
+
+#ifndef warm_start_micro
+#define warm_start_micro false
+#endif
+
+#ifndef texture_micro
+#define texture_micro false
+#endif
+
+#ifndef broyden_SC_micro
+#define broyden_SC_micro false
+#endif
+
+#ifndef precision_lazy_micro
+#define precision_lazy_micro 0.
+#endif
+
+#ifndef analytical_eshelby
+#define analytical_eshelby false
+#endif
+
+#ifndef adaptive_eshelby
+#define adaptive_eshelby false
+#endif
+
+#ifndef precision_eshelby
+#define precision_eshelby 1.E-6
+#endif
+
+#ifndef minorder_eshelby
+#define minorder_eshelby 8
+#endif
+
+#ifndef maxorder_eshelby
+#define maxorder_eshelby 256
+#endif
+
+#ifndef maxiter_fft
+#define maxiter_fft 1000
+#endif
+
+#ifndef precision_fft
+#define precision_fft 1E-6
+#endif
+
+#ifndef depth_anderson_fft
+#define depth_anderson_fft 5
+#endif
+
+#ifndef nvoxels_parallel_fft
+#define nvoxels_parallel_fft 4096
+#endif
+
+#ifndef nangles_parallel_ODF
+#define nangles_parallel_ODF 4096
+#endif
+
+#ifndef nworkers_identification
+#define nworkers_identification 0
+#endif
+
+#ifndef write_keys_identification
+#define write_keys_identification false
+#endif
+
+#ifndef memory_data_identification
+#define memory_data_identification true
+#endif
+
+#ifndef delta_sensi_identification
+#define delta_sensi_identification 0.01
+#endif
+
+#ifndef central_sensi_identification
+#define central_sensi_identification false
+#endif
+
+#ifndef adaptive_sensi_identification
+#define adaptive_sensi_identification false
+#endif
+
+#ifndef cache_identification
+#define cache_identification true
+#endif
+
+#ifndef quantum_cache_identification
+#define quantum_cache_identification 1.E-12
+#endif
+
+#ifndef persist_cache_identification
+#define persist_cache_identification false
+#endif
+
+#ifndef F_differential_evolution
+#define F_differential_evolution 0.7
+#endif
+
+#ifndef CR_differential_evolution
+#define CR_differential_evolution 0.9
+#endif
+
+#ifndef sigma_cmaes
+#define sigma_cmaes 0.3
+#endif
+
+#ifndef tolx_cmaes
+#define tolx_cmaes 1.E-8
+#endif
+
 } //namespace simcoon
@@ -24,9 +24,16 @@
 #include <assert.h>
 #include <math.h>
 #include <string.h>
+#include <map>
+#include <vector>
 #include <armadillo>
 #include <simcoon/parameter.hpp>
 #include <simcoon/Continuum_mechanics/Umat/umat_L_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/L_eff_table.hpp>
+#include <simcoon/Simulation/Maths/rotation.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
 #include <simcoon/Continuum_mechanics/Functions/natural_basis.hpp>
 #include <simcoon/Simulation/Solver/read.hpp>
 #include <simcoon/Simulation/Phase/state_variables_M.hpp>
@@ -70,5 +77,151 @@ int main() {
     output << sv_M->Lt << "\n";
     output.close();
     
+    //Batch mode: variants of the phases of the microstructure, listed in data/L_eff_batch.dat with the columns
+    //Variant Number c psi_mat theta_mat phi_mat a1 a2 a3 psi_geom theta_geom phi_geom (angles in degrees)
+    //The phases that are not listed for a variant keep the characteristics of Nellipsoids<N>.dat. The effective stiffness of each variant is written in L_batch.txt
+    ifstream batch(path_data + "/L_eff_batch.dat");
+    if (batch) {
+        std::map<string, int> list_umat = {{"MIHEN",100},{"MIMTN",101},{"MISCN",103}};
+        auto it_umat = list_umat.find(umat_name);
+        if (it_umat == list_umat.end()) {
+            cout << "Error: the batch mode is available for the micromechanical schemes of ellipsoidal phases only (MIHEN, MIMTN, MISCN)\n";
+            return 0;
+        }
+        
+        //Characteristics of the phases, in their material coordinate system
+        unsigned int nphases = rve.sub_phases.size();
+        vector<mat> L_base(nphases);
+        vector<vec> angles_base(nphases);
+        vector<ellipsoid> ell_base(nphases);
+        for (unsigned int j=0; j<nphases; j++) {
+            L_base[j] = std::dynamic_pointer_cast<state_variables_M>(rve.sub_phases[j].sptr_sv_local)->Lt;
+            angles_base[j] = {rve.sub_phases[j].sptr_matprops->psi_mat, rve.sub_phases[j].sptr_matprops->theta_mat, rve.sub_phases[j].sptr_matprops->phi_mat};
+            ell_base[j] = *std::dynamic_pointer_cast<ellipsoid>(rve.sub_phases[j].sptr_shape);
+        }
+        
+        vector<vector<vec> > angles;
+        vector<vector<ellipsoid> > ell;
+        vector<bool> listed;
+        string buffer;
+        getline(batch, buffer);
+        
+        unsigned int variant = 0;
+        unsigned int number = 0;
+        vec geom = zeros(10);
+        while (batch >> variant >> number >> geom(0) >> geom(1) >> geom(2) >> geom(3) >> geom(4) >> geom(5) >> geom(6) >> geom(7) >> geom(8) >> geom(9)) {
+            if (number >= nphases) {
+                cout << "Error: the phase " << number << " of the variant " << variant << " does not exist in the microstructure\n";
+                return 0;
+            }
+            if (variant >= ell.size()) {
+                angles.resize(variant+1, angles_base);
+                ell.resize(variant+1, ell_base);
+                listed.resize(variant+1, false);
+            }
+            listed[variant] = true;
+            angles[variant][number] = geom.subvec(1,3)*(sim_pi/180.);
+            ell[variant][number].concentration = geom(0);
+            ell[variant][number].a1 = geom(4);
+            ell[variant][number].a2 = geom(5);
+            ell[variant][number].a3 = geom(6);
+            ell[variant][number].psi_geom = geom(7)*(sim_pi/180.);
+            ell[variant][number].theta_geom = geom(8)*(sim_pi/180.);
+            ell[variant][number].phi_geom = geom(9)*(sim_pi/180.);
+        }
+        batch.close();
+        
+        //Only the variants listed in the file are evaluated, whatever their numbering
+        vector<unsigned int> variants;
+        vector<vector<ellipsoid> > ell_variants;
+        for (unsigned int i=0; i<ell.size(); i++) {
+            if (listed[i]) {
+                variants.push_back(i);
+                ell_variants.push_back(ell[i]);
+            }
+        }
+        
+        vector<vector<mat> > L(variants.size(), vector<mat>(nphases));
+        for (unsigned int i=0; i<variants.size(); i++) {
+            for (unsigned int j=0; j<nphases; j++) {
+                const vec &angles_ij = angles[variants[i]][j];
+                L[i][j] = rotate_l2g_L(L_base[j], angles_ij(0), angles_ij(1), angles_ij(2));
+            }
+        }
+        
+        int mp = rve.sptr_matprops->props(2);
+        int np = rve.sptr_matprops->props(3);
+        vec x = zeros(mp);
+        vec wx = zeros(mp);
+        vec y = zeros(np);
+        vec wy = zeros(np);
+        points(x, wx, y, wy, mp, np);
+        mat xi;
+        vec w;
+        directions(xi, w, x, wx, y, wy, mp, np);
+        
+        int n_matrix = rve.sptr_matprops->props(4);
+        vector<mat> L_eff = L_eff_batch(L, ell_variants, it_umat->second, n_matrix, xi, w);
+        
+        ofstream output_batch("L_batch.txt");
+        for (unsigned int i=0; i<L_eff.size(); i++) {
+            output_batch << variants[i];
+            for (int k=0; k<6; k++) {
+                for (int l=0; l<6; l++) {
+                    output_batch << "\t" << L_eff[i](k,l);
+                }
+            }
+            output_batch << "\n";
+        }
+        output_batch.close();
+    }
+    
+    //Table mode: grid of parameters of the phases of the microstructure, listed in data/L_eff_grid.dat with one axis per line
+    //Number parameter nvalues values... (parameter : c, a1, a2, a3, or p<j> for the material property props[j] of the phase)
+    //The table is written in L_eff_table.bin, to be utilized by the material MITAB once copied to data/L_eff_table<N>.bin
+    ifstream grid(path_data + "/L_eff_grid.dat");
+    if (grid) {
+        std::map<string, unsigned int> list_parameters = {{"c",0},{"a1",1},{"a2",2},{"a3",3}};
+        vector<unsigned int> number_axes;
+        vector<unsigned int> code_axes;
+        vector<vec> axes;
+        string buffer;
+        getline(grid, buffer);
+        
+        unsigned int number = 0;
+        string parameter;
+        unsigned int nvalues = 0;
+        while (grid >> number >> parameter >> nvalues) {
+            unsigned int code = 0;
+            if (list_parameters.count(parameter) > 0)
+                code = list_parameters[parameter];
+            else if ((parameter.size() > 1)&&(parameter[0] == 'p'))
+                code = 10 + stoi(parameter.substr(1));
+            else {
+                cout << "Error: the parameter " << parameter << " of the grid is not recognized\n";
+                return 0;
+            }
+            vec values = zeros(nvalues);
+            for (unsigned int k=0; k<nvalues; k++) {
+                grid >> values(k);
+            }
+            number_axes.push_back(number);
+            code_axes.push_back(code);
+            axes.push_back(values);
+        }
+        grid.close();
+        
+        umat parameters = zeros<umat>(axes.size(), 2);
+        for (unsigned int d=0; d<axes.size(); d++) {
+            parameters(d,0) = number_axes[d];
+            parameters(d,1) = code_axes[d];
+        }
+        
+        L_eff_table lt(parameters, axes);
+        lt.build(rve, 100);
+        lt.save("L_eff_table.bin");
+        cout << lt;
+    }
+    
 	return 0;
 }
@@ -73,9 +73,10 @@ int main() {
     string file_control = "ident_control.inp";
 
     string simul_type = "SOLVE";
+    string method = "GA";
 
     ident_essentials(n_param, n_consts, nfiles, path_data, file_essentials);
-    ident_control(ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, station_lim, probaMut, pertu, c, p0, lambdaLM, path_data, file_control);
-    run_identification(simul_type,n_param, n_consts, nfiles, ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, station_lim, path_data, path_keys, path_results, materialfile, outputfile, simulfile, probaMut, pertu, c, p0, lambdaLM);
+    ident_control(ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, station_lim, probaMut, pertu, c, p0, lambdaLM, method, path_data, file_control);
+    run_identification(simul_type,n_param, n_consts, nfiles, ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, station_lim, path_data, path_keys, path_results, materialfile, outputfile, simulfile, probaMut, pertu, c, p0, lambdaLM, method);
 
 }
@@ -22,8 +22,10 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <mutex>
 #include <assert.h>
 #include <armadillo>
+#include <simcoon/parameter.hpp>
 #include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
 #include <simcoon/Simulation/Maths/rotation.hpp>
 #include <simcoon/Simulation/Geometry/ellipsoid.hpp>
@@ -42,6 +44,19 @@ vec ellipsoid_multi::x;
 vec ellipsoid_multi::wx;
 vec ellipsoid_multi::y;
 vec ellipsoid_multi::wy;
+mat ellipsoid_multi::xi;
+vec ellipsoid_multi::wxi;
+bool ellipsoid_multi::analytical = analytical_eshelby;
+bool ellipsoid_multi::adaptive = adaptive_eshelby;
+
+//Protects the (re)definition of the integration points
+static std::mutex quadrature_mutex;
+
+//Geometry of the ellipsoid and integration settings on which the interaction tensor T depends, besides the tangent moduli
+static vec T_key(const ellipsoid &ell)
+{
+    return {ell.a1, ell.a2, ell.a3, ell.psi_geom, ell.theta_geom, ell.phi_geom, double(ellipsoid_multi::analytical), double(ellipsoid_multi::adaptive), double(ellipsoid_multi::mp), double(ellipsoid_multi::np)};
+}
     
     
 //=====Private methods for ellipsoid_multi===================================
@@ -53,7 +68,7 @@ vec ellipsoid_multi::wy;
 */
     
 //-------------------------------------------------------------
-ellipsoid_multi::ellipsoid_multi() : phase_multi(), S_loc(6,6), P_loc(6,6), T_loc(6,6), T(6,6), T_in_loc(6,6), T_in(6,6)
+ellipsoid_multi::ellipsoid_multi() : phase_multi(), S_loc(6,6), P_loc(6,6), T_loc(6,6), T(6,6), T_in_loc(6,6), T_in(6,6), method_T(0), order_S(minorder_eshelby)
 //-------------------------------------------------------------
 {
     //This calls only the constructor of the two matrix A & B
@@ -65,7 +80,7 @@ ellipsoid_multi::ellipsoid_multi() : phase_multi(), S_loc(6,6), P_loc(6,6), T_lo
 */
 
 //-------------------------------------------------------------
-ellipsoid_multi::ellipsoid_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const vec &mA_in, const mat &mS_loc, const mat &mP_loc, const mat &mT_loc, const mat &mT, const mat &mT_in_loc, const mat &mT_in) : phase_multi(mA, mA_start, mB, mB_start, mA_in), S_loc(6,6), P_loc(6,6), T_loc(6,6), T(6,6), T_in_loc(6,6), T_in(6,6)
+ellipsoid_multi::ellipsoid_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const vec &mA_in, const mat &mS_loc, const mat &mP_loc, const mat &mT_loc, const mat &mT, const mat &mT_in_loc, const mat &mT_in) : phase_multi(mA, mA_start, mB, mB_start, mA_in), S_loc(6,6), P_loc(6,6), T_loc(6,6), T(6,6), T_in_loc(6,6), T_in(6,6), method_T(0), order_S(minorder_eshelby)
 //-------------------------------------------------------------
 {
     S_loc = mS_loc;
@@ -82,7 +97,7 @@ ellipsoid_multi::ellipsoid_multi(const mat &mA, const mat &mA_start, const mat &
 */
     
 //------------------------------------------------------
-ellipsoid_multi::ellipsoid_multi(const ellipsoid_multi& pc) : phase_multi(pc), S_loc(6,6), P_loc(6,6), T_loc(6,6), T(6,6), T_in_loc(6,6), T_in(6,6)
+ellipsoid_multi::ellipsoid_multi(const ellipsoid_multi& pc) : phase_multi(pc), S_loc(6,6), P_loc(6,6), T_loc(6,6), T(6,6), T_in_loc(6,6), T_in(6,6), method_T(0), order_S(minorder_eshelby)
 //------------------------------------------------------
 {
     S_loc = pc.S_loc;
@@ -91,6 +106,11 @@ ellipsoid_multi::ellipsoid_multi(const ellipsoid_multi& pc) : phase_multi(pc), S
     T = pc.T;
     T_in_loc = pc.T_in_loc;
     T_in = pc.T_in;
+    Lt_m_T = pc.Lt_m_T;
+    Lt_T = pc.Lt_T;
+    geom_T = pc.geom_T;
+    method_T = pc.method_T;
+    order_S = pc.order_S;
 }
 
 /*!
@@ -103,16 +123,88 @@ ellipsoid_multi::ellipsoid_multi(const ellipsoid_multi& pc) : phase_multi(pc), S
 ellipsoid_multi::~ellipsoid_multi() {}
 //-------------------------------------
 
+/*!
+  \brief Definition of the integration points and weights shared by all the ellipsoids.
+  
+  Once defined, the points are only read by the fill* methods, so that the phases can be evaluated concurrently. They are only rebuilt if the number of points changes.
+  The corresponding unit directions and weights (xi, wxi) are tabulated here, so that the trigonometric functions are not evaluated at each Eshelby tensor computation.
+*/
+
+//-------------------------------------
+void ellipsoid_multi::set_quadrature(const int &mmp, const int &mnp)
+//-------------------------------------
+{
+    std::lock_guard<std::mutex> lock(quadrature_mutex);
+    if ((mmp == mp)&&(mnp == np)&&(x.n_elem == (unsigned int)mmp)&&(y.n_elem == (unsigned int)mnp)&&(xi.n_cols == (unsigned int)(mmp*mnp)))
+        return;
+    
+    vec mx = zeros(mmp);
+    vec mwx = zeros(mmp);
+    vec my = zeros(mnp);
+    vec mwy = zeros(mnp);
+    points(mx, mwx, my, mwy, mmp, mnp);
+    mat mxi;
+    vec mwxi;
+    directions(mxi, mwxi, mx, mwx, my, mwy, mmp, mnp);
+    
+    mp = mmp;
+    np = mnp;
+    x = mx;
+    wx = mwx;
+    y = my;
+    wy = mwy;
+    xi = mxi;
+    wxi = mwxi;
+}
+    
 /*!
   \brief Standard operator = for phase_multi
 */
 
+//-------------------------------------
+mat ellipsoid_multi::Eshelby_loc(const mat& Lt_m_loc, const ellipsoid &ell)
+//Closed-form solution if allowed and available, then adaptive or fixed quadrature
+//-------------------------------------
+{
+    mat S = zeros(6,6);
+    if ((analytical)&&(Eshelby_analytical(Lt_m_loc, ell.a1, ell.a2, ell.a3, S)))
+        return S;
+    
+    if (adaptive) {
+        //The previous order is the starting point of the next computation, as the tangent modulus evolves smoothly
+        int order = std::max(minorder_eshelby, order_S/2);
+        S = Eshelby_adaptive(Lt_m_loc, ell.a1, ell.a2, ell.a3, order);
+        order_S = order;
+        return S;
+    }
+    
+    return Eshelby(Lt_m_loc, ell.a1, ell.a2, ell.a3, xi, wxi);
+}
+    
+//-------------------------------------
+mat ellipsoid_multi::T_II_loc(const mat& Lt_m_loc, const ellipsoid &ell)
+//-------------------------------------
+{
+    mat S = zeros(6,6);
+    if ((analytical)&&(Eshelby_analytical(Lt_m_loc, ell.a1, ell.a2, ell.a3, S)))
+        return S*inv(Lt_m_loc);
+    
+    if (adaptive) {
+        int order = std::max(minorder_eshelby, order_S/2);
+        S = T_II_adaptive(Lt_m_loc, ell.a1, ell.a2, ell.a3, order);
+        order_S = order;
+        return S;
+    }
+    
+    return T_II(Lt_m_loc, ell.a1, ell.a2, ell.a3, xi, wxi);
+}
+    
 //-------------------------------------
 void ellipsoid_multi::fillS_loc(const mat& Lt_m, const ellipsoid &ell)
 //-------------------------------------
 {
     mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
-    S_loc = Eshelby(Ltm_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
+    S_loc = Eshelby_loc(Ltm_local_geom, ell);
 }
     
 //-------------------------------------
@@ -120,7 +212,7 @@ void ellipsoid_multi::fillP_loc(const mat& Lt_m, const ellipsoid &ell)
 //-------------------------------------
 {
     mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
-    P_loc = T_II(Ltm_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
+    P_loc = T_II_loc(Ltm_local_geom, ell);
 }
     
 
@@ -129,8 +221,9 @@ void ellipsoid_multi::fillT(const mat& Lt_m, const mat& Lt, const ellipsoid &ell
 //This method correspond to the classical Eshelby method
 //-------------------------------------
 {
+    method_T = 0; //direct computations are not tracked by updateT
     mat Lt_m_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
-    S_loc = Eshelby(Lt_m_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
+    S_loc = Eshelby_loc(Lt_m_local_geom, ell);
     mat Lt_local_geom = rotate_g2l_L(Lt, ell.psi_geom, ell.theta_geom, ell.phi_geom);
     
     T_loc = inv(eye(6,6) + S_loc*inv(Lt_m_local_geom)*(Lt_local_geom - Lt_m_local_geom));
@@ -143,8 +236,9 @@ void ellipsoid_multi::fillT_iso(const mat& Lt_m, const mat& Lt, const ellipsoid
 //This method corresponf to the isotropization method
 //-------------------------------------
 {
+    method_T = 0; //direct computations are not tracked by updateT
     mat Lt_m_iso = Isotropize(Lt_m);
-    S_loc = Eshelby(Lt_m_iso, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
+    S_loc = Eshelby_loc(Lt_m_iso, ell);
     mat Lt_local_geom = rotate_g2l_L(Lt, ell.psi_geom, ell.theta_geom, ell.phi_geom);
     
     T_loc = inv(eye(6,6) + S_loc*inv(Lt_m_iso)*(Lt_local_geom - Lt_m_iso));
@@ -158,8 +252,9 @@ void ellipsoid_multi::fillT_mec_in(const mat& L_m, const mat& L, const ellipsoid
 //the interaction tensors T for the elastic and the inelastic part.
 //-------------------------------------
 {
+    method_T = 0; //direct computations are not tracked by updateT
     mat L_m_local_geom = rotate_g2l_L(L_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
-    S_loc = Eshelby(L_m_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
+    S_loc = Eshelby_loc(L_m_local_geom, ell);
     mat L_local_geom = rotate_g2l_L(L, ell.psi_geom, ell.theta_geom, ell.phi_geom);
     
     T_loc = inv(eye(6,6) + S_loc*inv(L_m_local_geom)*(L_local_geom - L_m_local_geom));
@@ -169,6 +264,55 @@ void ellipsoid_multi::fillT_mec_in(const mat& L_m, const mat& L, const ellipsoid
     T_in = rotate_l2g_M(T_in_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
 }
     
+//-------------------------------------
+bool ellipsoid_multi::T_uptodate(const mat& Lt_m, const mat& Lt, const ellipsoid &ell, const int &method) const
+//The interaction tensor is kept if both tangent moduli changed less than precision_lazy_micro (relative Frobenius norm) since its last computation,
+//and if the geometry of the ellipsoid and the integration settings are unchanged
+//-------------------------------------
+{
+    if ((method_T != method)||(Lt_m_T.n_elem != 36)||(Lt_T.n_elem != 36))
+        return false;
+    
+    vec key = T_key(ell);
+    if ((geom_T.n_elem != key.n_elem)||(any(geom_T != key)))
+        return false;
+    
+    if (norm(Lt_m - Lt_m_T,"fro") > precision_lazy_micro*norm(Lt_m_T,"fro"))
+        return false;
+    
+    return (norm(Lt - Lt_T,"fro") <= precision_lazy_micro*norm(Lt_T,"fro"));
+}
+    
+//-------------------------------------
+bool ellipsoid_multi::updateT(const mat& Lt_m, const mat& Lt, const ellipsoid &ell)
+//-------------------------------------
+{
+    if (T_uptodate(Lt_m, Lt, ell, 1))
+        return false;
+    
+    fillT(Lt_m, Lt, ell);
+    Lt_m_T = Lt_m;
+    Lt_T = Lt;
+    geom_T = T_key(ell);
+    method_T = 1;
+    return true;
+}
+
+//-------------------------------------
+bool ellipsoid_multi::updateT_iso(const mat& Lt_m, const mat& Lt, const ellipsoid &ell)
+//-------------------------------------
+{
+    if (T_uptodate(Lt_m, Lt, ell, 2))
+        return false;
+    
+    fillT_iso(Lt_m, Lt, ell);
+    Lt_m_T = Lt_m;
+    Lt_T = Lt;
+    geom_T = T_key(ell);
+    method_T = 2;
+    return true;
+}
+    
 //----------------------------------------------------------------------
 ellipsoid_multi& ellipsoid_multi::operator = (const ellipsoid_multi& pc)
 //----------------------------------------------------------------------
@@ -179,12 +323,20 @@ ellipsoid_multi& ellipsoid_multi::operator = (const ellipsoid_multi& pc)
     A_start = pc.A_start;
     B_start = pc.B_start;
     
+    M_in = pc.M_in;
+    D_in = pc.D_in;
+    
     S_loc = pc.S_loc;
     P_loc = pc.P_loc;
     T_loc = pc.T_loc;
     T = pc.T;
     T_in_loc = pc.T_in_loc;
     T_in = pc.T_in;
+    Lt_m_T = pc.Lt_m_T;
+    Lt_T = pc.Lt_T;
+    geom_T = pc.geom_T;
+    method_T = pc.method_T;
+    order_S = pc.order_S;
     
 	return *this;
 }
@@ -201,6 +353,8 @@ ostream& operator << (ostream& s, const ellipsoid_multi& pc)
 
     s << "Display Eshelby tensor (local coordinates):\n";
     s << pc.S_loc;
+    if (ellipsoid_multi::adaptive)
+        s << "Order of the adaptive quadrature: " << pc.order_S << "\n";
     s << "Display Polarization tensor (local coordinates):\n";
     s << pc.P_loc;
     s << "Display Interaction concentration tensor (local coordinates):\n";
@@ -21,6 +21,8 @@
 ///@version 1.0
 
 #include <math.h>
+#include <map>
+#include <mutex>
 #include <armadillo>
 #include <simcoon/parameter.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
@@ -29,6 +31,10 @@ using namespace std;
 using namespace arma;
 
 namespace simcoon{
+
+//Integration directions of the adaptive quadrature, for each order. They are computed once and shared by all the calls (and threads)
+static std::map<int, std::pair<mat, vec> > adaptive_tables;
+static std::mutex adaptive_mutex;
     
 //Eshelby tensor for a sphere
 mat Eshelby_sphere(const double &nu) {
@@ -116,6 +122,81 @@ mat Eshelby_oblate(const double &nu, const double &ar) {
 	return S;
 }
 
+//Check if a stiffness tensor is isotropic, within a relative tolerance. If so, the Poisson ratio is returned in nu
+bool check_isotropic(const mat &Lt, double &nu, const double &tol) {
+    
+    double mu = (Lt(3,3)+Lt(4,4)+Lt(5,5))/3.;
+    double lambda = (Lt(0,1)+Lt(0,2)+Lt(1,2)+Lt(1,0)+Lt(2,0)+Lt(2,1))/6.;
+    
+    mat L_test = zeros(6,6);
+    for (int i=0; i<3; i++) {
+        for (int j=0; j<3; j++) {
+            L_test(i,j) = lambda;
+        }
+        L_test(i,i) += 2.*mu;
+        L_test(i+3,i+3) = mu;
+    }
+    
+    double norm_Lt = norm(Lt,"fro");
+    if ((norm_Lt < sim_iota)||(mu <= 0.)||(lambda + mu <= 0.))
+        return false;
+    
+    if (norm(Lt - L_test,"fro") > tol*norm_Lt)
+        return false;
+    
+    nu = lambda/(2.*(lambda+mu));
+    return true;
+}
+
+//Analytical Eshelby tensor for a spheroid embedded in an isotropic medium. Returns false if no closed-form solution is available, and S is left unchanged
+bool Eshelby_analytical(const mat &Lt, const double &a1, const double &a2, const double &a3, mat &S) {
+    
+    double nu = 0.;
+    if (!check_isotropic(Lt, nu))
+        return false;
+    
+    //Find the axis of revolution of the spheroid: the two other semi-axes shall be equal
+    int axis = 0;
+    double ar = 1.;
+    if (fabs(a2-a3) <= sim_limit*std::max(a2,a3)) {
+        axis = 1;
+        ar = a1/a2;
+    }
+    else if (fabs(a1-a3) <= sim_limit*std::max(a1,a3)) {
+        axis = 2;
+        ar = a2/a1;
+    }
+    else if (fabs(a1-a2) <= sim_limit*std::max(a1,a2)) {
+        axis = 3;
+        ar = a3/a1;
+    }
+    else
+        return false;
+    
+    mat S_axis = zeros(6,6);
+    //The closed-form prolate/oblate solutions lose accuracy close to the sphere: the numerical integration is utilized there
+    if (fabs(ar-1.) < 1.E-6)
+        S_axis = Eshelby_sphere(nu);
+    else if (fabs(ar-1.) < 1.E-3)
+        return false;
+    else if (ar > 1./sim_limit)
+        S_axis = Eshelby_cylinder(nu);
+    else if (ar > 1.)
+        S_axis = Eshelby_prolate(nu, ar);
+    else
+        S_axis = Eshelby_oblate(nu, ar);
+    
+    //The closed-form solutions are oriented such that the axis of revolution is the 1 direction; permute the Voigt indices otherwise
+    uvec perm = {0,1,2,3,4,5};
+    if (axis == 2)
+        perm = {1,0,2,3,5,4};
+    else if (axis == 3)
+        perm = {2,1,0,5,4,3};
+    
+    S = S_axis.submat(perm, perm);
+    return true;
+}
+
 //This methods is using the Voigt notations for the tensors.
 void calG(const double &pt, const double &a1, const double &a2, const double &a3, const double &x3, const Mat<int> &Id, const mat &Lt, mat &G)
 {
@@ -202,21 +283,10 @@ void Gauss(Mat<int> &Id, const mat &Lt, mat &G, const double &a1, const double &
 	}
 }
     
-mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
+//Voigt index of the symmetric pair (i,j)
+static Mat<int> Voigt_Id()
 {
-    mat G = zeros(6,6);
-	Mat<int> Id(6,6);
-    Id.zeros();
-
-    mat S = zeros(6,6);
-	int ij=0;
-	int mn=0;
-	int pq=0;
-	int ip=0;
-	int jq=0;
-	int jp=0;
-	int iq=0;
-		
+	Mat<int> Id(3,3);
     Id(0,0) = 0;
     Id(0,1) = 3;
     Id(0,2) = 4;
@@ -226,9 +296,22 @@ mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3,
     Id(2,0) = 4;
     Id(2,1) = 5;
     Id(2,2) = 2;
+    return Id;
+}
+
+//Contraction of the integrated Green operator G with the stiffness tensor L (L = I for the Hill tensor)
+static mat contract_G(const mat &G, const mat &L)
+{
+    Mat<int> Id = Voigt_Id();
+    mat S = zeros(6,6);
+	int ij=0;
+	int mn=0;
+	int pq=0;
+	int ip=0;
+	int jq=0;
+	int jp=0;
+	int iq=0;
     
-	Gauss(Id, Lt, G, a1, a2, a3, x, wx, y, wy, mp, np);
-	    
 	for (int i=0; i<3; i++) {
 		for (int j=i; j<3; j++) {
 			ij = Id(i,j);
@@ -242,7 +325,7 @@ mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3,
 							jq = Id(j,q);
 							jp = Id(j,p);
 							iq = Id(i,q);
-							S(ij,mn) = S(ij,mn)+Lt(pq,mn)*(G(ip,jq)+G(jp,iq));
+							S(ij,mn) = S(ij,mn)+L(pq,mn)*(G(ip,jq)+G(jp,iq));
 						}
 					}
 				}
@@ -260,10 +343,158 @@ mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3,
 		for (int j=0; j<6; j++) {
 			S(i,j) = S(i,j)*(1./(4.*sim_pi));
 		}
-	}   
+	}
+    return S;
+}
+    
+void directions(mat &xi, vec &w, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
+{
+    xi = zeros(3, mp*np);
+    w = zeros(mp*np);
+    
+    //The trigonometric functions are evaluated once per angle, and not at each point
+    vec cos_y = cos(y.head(np));
+    vec sin_y = sin(y.head(np));
+    
+    int pt = 0;
+	for (int l=0; l<mp; l++) {
+        double x1 = sqrt(1.-pow(x(l),2.));
+		for (int i=0; i<np; i++) {
+            pt = l*np + i;
+            xi(0,pt) = x1*cos_y(i);
+            xi(1,pt) = x1*sin_y(i);
+            xi(2,pt) = x(l);
+            w(pt) = wx(l)*wy(i);
+		}
+	}
+}
+    
+mat Gauss(const mat &Lt, const double &a1, const double &a2, const double &a3, const mat &xi, const vec &w)
+{
+    Mat<int> Id = Voigt_Id();
+    unsigned int npts = xi.n_cols;
+    
+    //Directions scaled by the semi-axes of the ellipsoid
+    mat X = xi;
+    X.row(0) *= (1./a1);
+    X.row(1) *= (1./a2);
+    X.row(2) *= (1./a3);
+    
+    //Products X_k X_l (Voigt index of kl)
+    mat XX(6, npts);
+    XX.row(0) = X.row(0)%X.row(0);
+    XX.row(1) = X.row(1)%X.row(1);
+    XX.row(2) = X.row(2)%X.row(2);
+    XX.row(3) = X.row(0)%X.row(1);
+    XX.row(4) = X.row(0)%X.row(2);
+    XX.row(5) = X.row(1)%X.row(2);
+    
+    //Christoffel tensor K_ik = L_ijkl X_j X_l (Voigt index of ik), at all the points at once
+    mat rk(6, npts);
+    mat M = zeros(3,3);
+	for (int i=0; i<3; i++) {
+		for (int k=i; k<3; k++) {
+            for (int j=0; j<3; j++) {
+                for (int l=0; l<3; l++) {
+                    M(j,l) = Lt(Id(i,j),Id(k,l));
+                }
+            }
+            rk.row(Id(i,k)) = sum((M*X)%X, 0);
+		}
+	}
+    
+    //Inverse of the Christoffel tensor, from its cofactors
+    mat rn(6, npts);
+    rn.row(0) = rk.row(1)%rk.row(2) - rk.row(5)%rk.row(5);
+    rn.row(3) = -1.*(rk.row(3)%rk.row(2) - rk.row(5)%rk.row(4));
+    rn.row(4) = rk.row(3)%rk.row(5) - rk.row(1)%rk.row(4);
+    rn.row(1) = rk.row(0)%rk.row(2) - rk.row(4)%rk.row(4);
+    rn.row(5) = -1.*(rk.row(0)%rk.row(5) - rk.row(3)%rk.row(4));
+    rn.row(2) = rk.row(0)%rk.row(1) - rk.row(3)%rk.row(3);
+    
+    rowvec D = rn.row(0)%rk.row(0) + rn.row(3)%rk.row(3) + rn.row(4)%rk.row(4);
+    rn.each_row() %= (w.t()/D);
+    
+    //G_ijkl = sum over the points of w N_ij X_k X_l
+    return rn*XX.t();
+}
+    
+mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3, const mat &xi, const vec &w)
+{
+    mat G = Gauss(Lt, a1, a2, a3, xi, w);
+    return contract_G(G, Lt);
+}
+
+mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
+{
+    mat xi;
+    vec w;
+    directions(xi, w, x, wx, y, wy, mp, np);
+    return Eshelby(Lt, a1, a2, a3, xi, w);
+}
+
+mat Eshelby_select(const mat &Lt, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
+{
+    mat S = zeros(6,6);
+    if (Eshelby_analytical(Lt, a1, a2, a3, S))
+        return S;
+    else
+        return Eshelby(Lt, a1, a2, a3, x, wx, y, wy, mp, np);
+}
+
+mat Eshelby_select(const mat &Lt, const double &a1, const double &a2, const double &a3, const mat &xi, const vec &w)
+{
+    mat S = zeros(6,6);
+    if (Eshelby_analytical(Lt, a1, a2, a3, S))
+        return S;
+    else
+        return Eshelby(Lt, a1, a2, a3, xi, w);
+}
+
+//Table of integration directions of an order x order Gauss quadrature. Entries of the map are never modified nor erased once created
+static const std::pair<mat, vec>& adaptive_table(const int &order)
+{
+    std::lock_guard<std::mutex> lock(adaptive_mutex);
+    auto it = adaptive_tables.find(order);
+    if (it != adaptive_tables.end())
+        return it->second;
+    
+    vec x = zeros(order);
+    vec wx = zeros(order);
+    vec y = zeros(order);
+    vec wy = zeros(order);
+    points(x, wx, y, wy, order, order);
+    std::pair<mat, vec> &table = adaptive_tables[order];
+    directions(table.first, table.second, x, wx, y, wy, order, order);
+    return table;
+}
+    
+//The order is doubled until two successive tensors differ less than tol (relative Frobenius norm), or the maximal order is reached.
+//The starting order is bounded by order_max/2, so that at least two orders are always compared
+static mat adaptive_integration(const mat &Lt, const mat &L, const double &a1, const double &a2, const double &a3, int &order, const double &tol, const int &order_max)
+{
+    int n = std::max(std::min(order, order_max/2), 1);
+    const std::pair<mat, vec> &table_0 = adaptive_table(n);
+    mat S = contract_G(Gauss(Lt, a1, a2, a3, table_0.first, table_0.second), L);
+    mat S_prev = S;
+    
+    while (2*n <= order_max) {
+        n *= 2;
+        const std::pair<mat, vec> &table = adaptive_table(n);
+        S_prev = S;
+        S = contract_G(Gauss(Lt, a1, a2, a3, table.first, table.second), L);
+        if (norm(S - S_prev,"fro") <= tol*norm(S,"fro"))
+            break;
+    }
+    order = n;
     return S;
 }
 
+mat Eshelby_adaptive(const mat &Lt, const double &a1, const double &a2, const double &a3, int &order, const double &tol, const int &order_max)
+{
+    return adaptive_integration(Lt, Lt, a1, a2, a3, order, tol, order_max);
+}
+    
 mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3, const int &mp, const int &np) {
     
     vec x(mp);
@@ -296,70 +527,43 @@ mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3,
     return T_II;
 }*/
 
+mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, const mat &xi, const vec &w)
+{
+    mat G = Gauss(Lt, a1, a2, a3, xi, w);
+    return contract_G(G, eye(6,6));
+}
+
 mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
-{   
-	mat G = zeros(6,6);
-	Mat<int> Id(6,6);
-    Id.zeros();
-    
-    mat T_II = zeros(6,6);
-    mat I = eye(6,6);
-    
-	int ij=0;
-	int mn=0;
-	int pq=0;
-	int ip=0;
-	int jq=0;
-	int jp=0;
-	int iq=0;
-    
-    Id(0,0) = 0;
-    Id(0,1) = 3;
-    Id(0,2) = 4;
-    Id(1,0) = 3;
-    Id(1,1) = 1;
-    Id(1,2) = 5;
-    Id(2,0) = 4;
-    Id(2,1) = 5;
-    Id(2,2) = 2;
-        
-	Gauss(Id, Lt, G, a1, a2, a3, x, wx, y, wy, mp, np);
-		
-	for (int i=0; i<3; i++) {
-		for (int j=i; j<3; j++) {
-			ij = Id(i,j);
-			for (int m=0; m<3; m++) {
-				for (int n=m; n<3; n++) {
-					mn = Id(m,n);
-					for (int p=0; p<3; p++) {
-						for (int q=0; q<3; q++) {
-							pq = Id(p,q);
-							ip = Id(i,p);
-							jq = Id(j,q);
-							jp = Id(j,p);
-							iq = Id(i,q);
-							T_II(ij,mn) = T_II(ij,mn)+I(pq,mn)*(G(ip,jq)+G(jp,iq));
-						}
-					}
-				}
-			}
-		}
-	}
-	
-	for (int i=0; i<3; i++) {
-		for (int j=0; j<6; j++) {
-			T_II(i,j) = T_II(i,j)*(1./(8.*sim_pi));
-		}
-	}
-    
-	for (int i=3; i<6; i++) {
-		for (int j=0; j<6; j++) {
-			T_II(i,j) = T_II(i,j)*(1./(4.*sim_pi));
-		}
-	}    
-    return T_II;
+{
+    mat xi;
+    vec w;
+    directions(xi, w, x, wx, y, wy, mp, np);
+    return T_II(Lt, a1, a2, a3, xi, w);
+}
+
+mat T_II_select(const mat &Lt, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
+{
+    mat S = zeros(6,6);
+    if (Eshelby_analytical(Lt, a1, a2, a3, S))
+        return S*inv(Lt);
+    else
+        return T_II(Lt, a1, a2, a3, x, wx, y, wy, mp, np);
 }
 
+mat T_II_select(const mat &Lt, const double &a1, const double &a2, const double &a3, const mat &xi, const vec &w)
+{
+    mat S = zeros(6,6);
+    if (Eshelby_analytical(Lt, a1, a2, a3, S))
+        return S*inv(Lt);
+    else
+        return T_II(Lt, a1, a2, a3, xi, w);
+}
+
+mat T_II_adaptive(const mat &Lt, const double &a1, const double &a2, const double &a3, int &order, const double &tol, const int &order_max)
+{
+    return adaptive_integration(Lt, eye(6,6), a1, a2, a3, order, tol, order_max);
+}
+    
 mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, const int &mp, const int &np) {
     
     vec x(mp);
@@ -24,6 +24,9 @@
 #include <string>
 #include <assert.h>
 #include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/rotation.hpp>
+#include <simcoon/Simulation/Geometry/layer.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/layer_multi.hpp>
 
 using namespace std;
@@ -40,7 +43,7 @@ namespace simcoon{
 */
 
 //-------------------------------------------------------------
-layer_multi::layer_multi() : phase_multi(), Dnn(3,3), Dnt(3,3), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
+layer_multi::layer_multi() : phase_multi(), Dnn(3,3), Dnt(3,3), inv_Dnn(3,3), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
 //-------------------------------------------------------------
 {
 
@@ -51,7 +54,7 @@ layer_multi::layer_multi() : phase_multi(), Dnn(3,3), Dnt(3,3), dXn(3,3), dXt(3,
 */
 
 //-------------------------------------------------------------
-layer_multi::layer_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const vec &mA_in, const mat &mDnn, const mat &mDnt, const mat &mdXn, const mat &mdXt, const vec &msigma_hat, const vec &mdzdx1) : phase_multi(mA, mA_start, mB, mB_start, mA_in), Dnn(3,3), Dnt(3,3), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
+layer_multi::layer_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const vec &mA_in, const mat &mDnn, const mat &mDnt, const mat &mdXn, const mat &mdXt, const vec &msigma_hat, const vec &mdzdx1) : phase_multi(mA, mA_start, mB, mB_start, mA_in), Dnn(3,3), Dnt(3,3), inv_Dnn(3,3), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
 //-------------------------------------------------------------
 {
     Dnn = mDnn;
@@ -73,6 +76,12 @@ layer_multi::layer_multi(const layer_multi& pc) : phase_multi(pc)
 {
     Dnn = pc.Dnn;
     Dnt = pc.Dnt;
+    inv_Dnn = pc.inv_Dnn;
+    Lt_D = pc.Lt_D;
+    QS_n = pc.QS_n;
+    QS_t = pc.QS_t;
+    QE = pc.QE;
+    angles_Q = pc.angles_Q;
     dXn = pc.dXn;
     dXt = pc.dXt;
     sigma_hat = pc.sigma_hat;
@@ -89,6 +98,82 @@ layer_multi::layer_multi(const layer_multi& pc) : phase_multi(pc)
 layer_multi::~layer_multi() {}
 //-------------------------------------
 
+/*!
+  \brief Rotations from the global coordinate system to the coordinate system of the layer
+  
+  The composite rotations are computed once per orientation of the layer, instead of rotating each tensor about the three Euler axes at each call. When they are recomputed, Dnn, Dnt and inv_Dnn are invalidated.
+*/
+
+//-------------------------------------
+void layer_multi::updateQ(const layer &lay)
+//-------------------------------------
+{
+    vec angles = {lay.psi_geom, lay.theta_geom, lay.phi_geom};
+    if ((angles_Q.n_elem == 3)&&(norm(angles - angles_Q,"inf") <= sim_iota))
+        return;
+    
+    mat QS = zeros(6,6);
+    QE = zeros(6,6);
+    vec e = zeros(6);
+    for (unsigned int j=0; j<6; j++) {
+        e.zeros();
+        e(j) = 1.;
+        QS.col(j) = rotate_g2l_stress(e, lay.psi_geom, lay.theta_geom, lay.phi_geom);
+        QE.col(j) = rotate_g2l_strain(e, lay.psi_geom, lay.theta_geom, lay.phi_geom);
+    }
+    QS_n = QS.rows(uvec({0,3,4}));
+    QS_t = QS.rows(uvec({1,2,5}));
+    angles_Q = angles;
+    Lt_D.reset();
+}
+
+/*!
+  \brief Normal and tangent parts of the tangent modulus in the coordinate system of the layer
+  
+  They are kept if the tangent modulus changed less than precision_lazy_micro (relative Frobenius norm) since their last computation, and the orientation of the layer is unchanged.
+*/
+
+//-------------------------------------
+bool layer_multi::updateD(const mat &Lt, const layer &lay)
+//-------------------------------------
+{
+    updateQ(lay);
+    if ((Lt_D.n_elem == 36)&&(norm(Lt - Lt_D,"fro") <= precision_lazy_micro*norm(Lt_D,"fro")))
+        return false;
+    
+    //Rows (1,4,5) of the tangent modulus in the coordinate system of the layer, split into its normal (1,4,5) and tangent (2,3,6) columns
+    mat QL_n = QS_n*Lt;
+    Dnn = QL_n*QS_n.t();
+    Dnt = QL_n*QS_t.t();
+    
+    inv_Dnn = inv(Dnn);
+    Lt_D = Lt;
+    return true;
+}
+    
+//-------------------------------------
+void layer_multi::fillA(const mat &m_n, const mat &m_t, const layer &lay)
+//-------------------------------------
+{
+    updateQ(lay);
+    
+    dXn = inv_Dnn*(m_n-Dnn);
+    dXt = inv_Dnn*(m_t-Dnt);
+    
+    //Only the rows (1,4,5) of the strain concentration tensor in the coordinate system of the layer differ from the identity
+    mat dA_loc = zeros(3,6);
+    dA_loc.col(0) = dXn.col(0);
+    dA_loc.col(1) = dXt.col(0);
+    dA_loc.col(2) = dXt.col(1);
+    dA_loc.col(3) = dXn.col(1);
+    dA_loc.col(4) = dXn.col(2);
+    dA_loc.col(5) = dXt.col(2);
+    
+    //The strain rotation from local to global is the transpose of the stress rotation from global to local
+    A = eye(6,6) + QS_n.t()*(dA_loc*QE);
+}
+
+    
 /*!
   \brief Standard operator = for phase_multi
 */
@@ -105,6 +190,12 @@ layer_multi& layer_multi::operator = (const layer_multi& pc)
     
     Dnn = pc.Dnn;
     Dnt = pc.Dnt;
+    inv_Dnn = pc.inv_Dnn;
+    Lt_D = pc.Lt_D;
+    QS_n = pc.QS_n;
+    QS_t = pc.QS_t;
+    QE = pc.QE;
+    angles_Q = pc.angles_Q;
     dXn = pc.dXn;
     dXt = pc.dXt;
     sigma_hat = pc.sigma_hat;
@@ -40,10 +40,11 @@ namespace simcoon{
 */
 
 //-------------------------------------------------------------
-phase_multi::phase_multi() : A(6,6), A_start(6,6), B(6,6), B_start(6,6), A_in(6)
+phase_multi::phase_multi() : A(6,6), A_start(6,6), B(6,6), B_start(6,6), A_in(6), DE_corr(6), M_in(6,6)
 //-------------------------------------------------------------
 {
-    
+    DE_corr.zeros();
+    M_in.zeros();
 }
 
 /*!
@@ -51,7 +52,7 @@ phase_multi::phase_multi() : A(6,6), A_start(6,6), B(6,6), B_start(6,6), A_in(6)
 */
 
 //-------------------------------------------------------------
-phase_multi::phase_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const vec &mA_in) : A(6,6), A_start(6,6), B(6,6), B_start(6,6), A_in(6)
+phase_multi::phase_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const vec &mA_in) : A(6,6), A_start(6,6), B(6,6), B_start(6,6), A_in(6), DE_corr(6), M_in(6,6)
 //-------------------------------------------------------------
 {
     A = mA;
@@ -61,6 +62,8 @@ phase_multi::phase_multi(const mat &mA, const mat &mA_start, const mat &mB, cons
     B_start = mB_start;
     
     A_in = mA_in;
+    DE_corr.zeros();
+    M_in.zeros();
 }
 
 /*!
@@ -69,7 +72,7 @@ phase_multi::phase_multi(const mat &mA, const mat &mA_start, const mat &mB, cons
 */
     
 //------------------------------------------------------
-phase_multi::phase_multi(const phase_multi& pc) : A(6,6), A_start(6,6), B(6,6), B_start(6,6), A_in(6)
+phase_multi::phase_multi(const phase_multi& pc) : A(6,6), A_start(6,6), B(6,6), B_start(6,6), A_in(6), DE_corr(6), M_in(6,6)
 //------------------------------------------------------
 {
     A = pc.A;
@@ -79,6 +82,9 @@ phase_multi::phase_multi(const phase_multi& pc) : A(6,6), A_start(6,6), B(6,6),
     B_start = pc.B_start;
     
     A_in = pc.A_in;
+    DE_corr = pc.DE_corr;
+    M_in = pc.M_in;
+    D_in = pc.D_in;
 }
 
 /*!
@@ -104,7 +110,7 @@ void phase_multi::to_start()
 }
 
 //-------------------------------------------------------------
-void phase_multi::set_start()
+void phase_multi::set_start(const int &)
 //-------------------------------------------------------------
 {
     A_start = A;
@@ -122,6 +128,9 @@ phase_multi& phase_multi::operator = (const phase_multi& pc)
     B_start = pc.B_start;
     
     A_in = pc.A_in;
+    DE_corr = pc.DE_corr;
+    M_in = pc.M_in;
+    D_in = pc.D_in;
     
 	return *this;
 }
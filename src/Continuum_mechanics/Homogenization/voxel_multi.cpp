@@ -0,0 +1,204 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file voxel_multi.cpp
+///@brief Voxels of a phase of a periodic voxel microstructure
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <assert.h>
+#include <armadillo>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/voxel_multi.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+//=====Private methods for voxel_multi===================================
+
+//=====Public methods for voxel_multi====================================
+
+/*!
+  \brief default constructor
+*/
+
+//-------------------------------------------------------------
+voxel_multi::voxel_multi() : phase_multi(), n1(0), n2(0), n3(0), lambda_0(0.), mu_0(0.)
+//-------------------------------------------------------------
+{
+
+}
+
+/*!
+  \brief Copy constructor
+  \param s voxel_multi object to duplicate
+*/
+    
+//------------------------------------------------------
+voxel_multi::voxel_multi(const voxel_multi& pc) : phase_multi(pc)
+//------------------------------------------------------
+{
+    n1 = pc.n1;
+    n2 = pc.n2;
+    n3 = pc.n3;
+    index = pc.index;
+    lambda_0 = pc.lambda_0;
+    mu_0 = pc.mu_0;
+    
+    Etot = pc.Etot;
+    DEtot = pc.DEtot;
+    sigma = pc.sigma;
+    sigma_start = pc.sigma_start;
+    statev = pc.statev;
+    statev_start = pc.statev_start;
+    Wm = pc.Wm;
+    Wm_start = pc.Wm_start;
+    Lt = pc.Lt;
+}
+
+/*!
+  \brief Destructor
+
+  Deletes voxel_multi (the arma::mat).
+*/
+
+//-------------------------------------
+voxel_multi::~voxel_multi() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+unsigned int voxel_multi::size() const
+//-------------------------------------------------------------
+{
+    return index.n_elem;
+}
+
+//-------------------------------------------------------------
+void voxel_multi::fill(const state_variables_M &sv)
+//-------------------------------------------------------------
+{
+    unsigned int nvoxels = size();
+    Etot = repmat(sv.Etot, 1, nvoxels);
+    DEtot = repmat(sv.DEtot, 1, nvoxels);
+    sigma = repmat(sv.sigma, 1, nvoxels);
+    sigma_start = repmat(sv.sigma_start, 1, nvoxels);
+    statev = repmat(sv.statev, 1, nvoxels);
+    statev_start = repmat(sv.statev_start, 1, nvoxels);
+    Wm = repmat(sv.Wm, 1, nvoxels);
+    Wm_start = repmat(sv.Wm_start, 1, nvoxels);
+    Lt = repmat(vectorise(sv.Lt), 1, nvoxels);
+}
+
+//-------------------------------------------------------------
+void voxel_multi::get(const unsigned int &i, state_variables_M &sv) const
+//-------------------------------------------------------------
+{
+    sv.Etot = Etot.col(i);
+    sv.DEtot = DEtot.col(i);
+    sv.sigma_start = sigma_start.col(i);
+    sv.sigma = sv.sigma_start;
+    sv.statev_start = statev_start.col(i);
+    sv.statev = sv.statev_start;
+    sv.Wm_start = Wm_start.col(i);
+    sv.Wm = sv.Wm_start;
+}
+
+//-------------------------------------------------------------
+void voxel_multi::set(const unsigned int &i, const state_variables_M &sv)
+//-------------------------------------------------------------
+{
+    sigma.col(i) = sv.sigma;
+    statev.col(i) = sv.statev;
+    Wm.col(i) = sv.Wm;
+    Lt.col(i) = vectorise(sv.Lt);
+}
+
+//-------------------------------------------------------------
+void voxel_multi::to_start()
+//-------------------------------------------------------------
+{
+    phase_multi::to_start();
+    sigma = sigma_start;
+    statev = statev_start;
+    Wm = Wm_start;
+}
+
+//-------------------------------------------------------------
+void voxel_multi::set_start(const int &corate_type)
+//-------------------------------------------------------------
+{
+    //The full-field problems are solved in small strains: the fields of the voxels are not rotated
+    phase_multi::set_start(corate_type);
+    sigma_start = sigma;
+    statev_start = statev;
+    Wm_start = Wm;
+    Etot += DEtot;
+}
+    
+/*!
+  \brief Standard operator = for voxel_multi
+*/
+
+//----------------------------------------------------------------------
+voxel_multi& voxel_multi::operator = (const voxel_multi& pc)
+//----------------------------------------------------------------------
+{
+    phase_multi::operator=(pc);
+    
+    n1 = pc.n1;
+    n2 = pc.n2;
+    n3 = pc.n3;
+    index = pc.index;
+    lambda_0 = pc.lambda_0;
+    mu_0 = pc.mu_0;
+    
+    Etot = pc.Etot;
+    DEtot = pc.DEtot;
+    sigma = pc.sigma;
+    sigma_start = pc.sigma_start;
+    statev = pc.statev;
+    statev_start = pc.statev_start;
+    Wm = pc.Wm;
+    Wm_start = pc.Wm_start;
+    Lt = pc.Lt;
+    
+    return *this;
+}
+    
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const voxel_multi& pc)
+//--------------------------------------------------------------------------
+{
+	s << "Display voxel multi:\n";
+	s << "Display strain concentration tensor:\n";
+    s << pc.A;
+    s << "Display stress concentration tensor:\n";
+    s << pc.B;
+
+    s << "Display grid: " << pc.n1 << " x " << pc.n2 << " x " << pc.n3 << "\n";
+    s << "Display number of voxels of the phase: " << pc.size() << "\n";
+    
+    s << "\n\n";
+
+	return s;
+}
+
+} //namespace simcoon
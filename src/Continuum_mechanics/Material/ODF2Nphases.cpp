@@ -44,6 +44,13 @@ namespace simcoon{
     
 vec get_densities_ODF(const vec &x, const string &path_data, const string &input_peaks, const bool &radian) {
     
+    ODF odf_rve(0, radian, x.min(), x.max());
+    read_peak(odf_rve, path_data, input_peaks);
+    return get_densities_ODF(x, odf_rve, radian);
+}
+    
+vec get_densities_ODF(const vec &x, const ODF &odf_rve, const bool &radian, const bool &parallel) {
+    
     vec y = zeros(x.n_elem);
     vec x_rad;
     if (!radian) {
@@ -68,16 +75,10 @@ vec get_densities_ODF(const vec &x, const string &path_data, const string &input
         }
     }
     
-    ODF odf_rve(0, radian, x.min(), x.max());
-    read_peak(odf_rve, path_data, input_peaks);
-    
-    for(unsigned int i=0; i<x.n_elem; i++) {
-        if (radian)
-            y(i) = odf_rve.density(x(i));
-        else
-            y(i) = odf_rve.density(x_rad(i));
-    }
-    return y;
+    if (radian)
+        return odf_rve.density(x, parallel);
+    else
+        return odf_rve.density(x_rad, parallel);
 }
     
 void fill_angles(const double &alpha, phase_characteristics &phase, const ODF &odf_rve, const int &angles_mat) {
@@ -144,46 +145,47 @@ phase_characteristics discretize_ODF(const phase_characteristics &rve_init, ODF
     phase_characteristics rve;
     rve.copy(rve_init);
     
-    int number = 0;
-    odf_rve.norm = 0.;
-    
     double angle_range = odf_rve.limits(1) - odf_rve.limits(0);
     assert(angle_range > 0.);
     
     double dalpha = angle_range/double(nb_phases_disc);
     double alpha = odf_rve.limits(0);
     
-    rve.sub_phases.erase(rve.sub_phases.begin()+num_phase_disc);
+    //The angles and the concentrations of all the bins are computed first (Simpson rule, the density is evaluated at once for all the angles)
+    vec alphas = zeros(nb_phases_disc);
+    vec alphas_left = zeros(nb_phases_disc);
     for (int i=0; i<nb_phases_disc; i++) {
-        
-        phase_characteristics temp;
-        temp.copy(rve_init.sub_phases[num_phase_disc]);
-        
-        fill_angles(alpha, temp, odf_rve, angles_mat);
-        
-        if(alpha - odf_rve.limits(0) < dalpha)
-            temp.sptr_shape->concentration = dalpha/6. * (odf_rve.density(sim_pi+alpha-dalpha/2) + 4.*odf_rve.density(alpha) + odf_rve.density(alpha+dalpha/2));
-        else
-            temp.sptr_shape->concentration = dalpha/6. * (odf_rve.density(alpha-dalpha/2) + 4.*odf_rve.density(alpha) + odf_rve.density(alpha+dalpha/2));
-
-        odf_rve.norm += temp.sptr_shape->concentration;
-        
-        rve.sub_phases.insert(rve.sub_phases.begin()+i+num_phase_disc, temp);
+        alphas(i) = alpha;
+        alphas_left(i) = (alpha - odf_rve.limits(0) < dalpha) ? sim_pi+alpha-dalpha/2 : alpha-dalpha/2;
         alpha += dalpha;
     }
+    vec concentrations = dalpha/6. * (odf_rve.density(alphas_left, true) + 4.*odf_rve.density(alphas, true) + odf_rve.density(alphas+dalpha/2, true));
     
     ///Normalization
-    for(int i=0; i<nb_phases_disc; i++) {
-        rve.sub_phases[i+num_phase_disc].sptr_shape->concentration *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / odf_rve.norm);
+    odf_rve.norm = sum(concentrations);
+    concentrations *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / odf_rve.norm);
+    
+    //The phases are then built in a single pass: the other phases are moved, and the discretized phase is copied once per bin
+    std::vector<phase_characteristics> sub_phases;
+    sub_phases.reserve(rve.sub_phases.size() - 1 + nb_phases_disc);
+    for (int i=0; i<num_phase_disc; i++) {
+        sub_phases.push_back(std::move(rve.sub_phases[i]));
     }
+    for (int i=0; i<nb_phases_disc; i++) {
+        sub_phases.emplace_back();
+        sub_phases.back().copy(rve_init.sub_phases[num_phase_disc]);
+        fill_angles(alphas(i), sub_phases.back(), odf_rve, angles_mat);
+        sub_phases.back().sptr_shape->concentration = concentrations(i);
+    }
+    for (unsigned int i=num_phase_disc+1; i<rve.sub_phases.size(); i++) {
+        sub_phases.push_back(std::move(rve.sub_phases[i]));
+    }
+    rve.sub_phases = std::move(sub_phases);
     
     for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
-        rve.sub_phases[i].sptr_matprops->number = number;
-        number++;
+        rve.sub_phases[i].sptr_matprops->number = i;
     }
     
-//    cout << "rve = " << rve;
-    
     return rve;
     
 }
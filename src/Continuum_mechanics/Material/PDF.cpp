@@ -23,12 +23,14 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <algorithm>
 #include <assert.h>
 #include <armadillo>
 #include <memory>
 #include <simcoon/parameter.hpp>
 #include <simcoon/Continuum_mechanics/Material/peak.hpp>
 #include <simcoon/Continuum_mechanics/Material/PDF.hpp>
+#include <simcoon/Simulation/Maths/parallel.hpp>
 
 
 using namespace std;
@@ -139,11 +141,36 @@ double PDF::density(const double &alpha)
 {
     double density = 0.;
     
-    for(auto p : peaks) {
+    for(auto &p : peaks) {
         density += p.get_density_PDF(alpha);
     }
     return density;
 }
+
+//----------------------------------------------------------------------
+vec PDF::density(const vec &alpha, const bool &parallel) const
+//----------------------------------------------------------------------
+{
+    vec density = zeros(alpha.n_elem);
+    
+    if ((!parallel)||(alpha.n_elem <= nangles_parallel_ODF)) {
+        for(auto &p : peaks) {
+            density += p.get_density_PDF(alpha);
+        }
+        return density;
+    }
+    
+    unsigned int nblocks = (alpha.n_elem + nangles_parallel_ODF - 1)/nangles_parallel_ODF;
+    parallel_for(nblocks, [&](const unsigned int &b) {
+        unsigned int first = b*nangles_parallel_ODF;
+        unsigned int last = std::min<uword>(first + nangles_parallel_ODF, alpha.n_elem) - 1;
+        vec alpha_b = alpha.subvec(first, last);
+        for(auto &p : peaks) {
+            density.subvec(first, last) += p.get_density_PDF(alpha_b);
+        }
+    });
+    return density;
+}
     
     
 //----------------------------------------------------------------------
@@ -44,16 +44,14 @@ namespace simcoon{
     
 vec get_densities_PDF(const vec &x, const string &path_data, const string &input_peaks) {
     
-    vec y = zeros(x.n_elem);
-    
     PDF pdf_rve(0, x.min(), x.max());
     read_peak(pdf_rve, path_data, input_peaks);
+    return get_densities_PDF(x, pdf_rve);
+}
     
-    for(unsigned int i=0; i<x.n_elem; i++) {
-		y(i) = pdf_rve.density(x(i));
-	}
+vec get_densities_PDF(const vec &x, const PDF &pdf_rve, const bool &parallel) {
     
-    return y;
+    return pdf_rve.density(x, parallel);
 }
     
 void fill_parameters(const double &alpha, phase_characteristics &phase, const PDF &pdf_rve) {
@@ -67,48 +65,45 @@ phase_characteristics discretize_PDF(const phase_characteristics &rve_init, PDF
     phase_characteristics rve;
     rve.copy(rve_init);
     
-    int number = 0;
-    pdf_rve.norm = 0.;
-    
     double parameter_range = pdf_rve.limits(1) - pdf_rve.limits(0);
     assert(parameter_range > 0.);
     
     double dalpha = parameter_range/double(nb_phases_disc);
     double alpha = pdf_rve.limits(0);
     
-    rve.sub_phases.erase(rve.sub_phases.begin()+num_phase_disc);
+    //The parameters and the concentrations of all the bins are computed first (Simpson rule, the density is evaluated at once for all the parameters)
+    vec alphas = zeros(nb_phases_disc);
     for (int i=0; i<nb_phases_disc; i++) {
-        
-        phase_characteristics temp;
-        temp.copy(rve_init.sub_phases[num_phase_disc]);
-        
-        fill_parameters(alpha, temp, pdf_rve);
-        
-        // if(alpha - pdf_rve.limits(0) < dalpha)
-            // temp.sptr_shape->concentration = dalpha/6. * (pdf_rve.density(pi+alpha-dalpha/2) + 4.*pdf_rve.density(alpha) + pdf_rve.density(alpha+dalpha/2));
-        // else
-            // temp.sptr_shape->concentration = dalpha/6. * (pdf_rve.density(alpha-dalpha/2) + 4.*pdf_rve.density(alpha) + pdf_rve.density(alpha+dalpha/2));
-            
-        temp.sptr_shape->concentration = dalpha/6. * (pdf_rve.density(alpha-dalpha/2) + 4.*pdf_rve.density(alpha) + pdf_rve.density(alpha+dalpha/2));
-
-        pdf_rve.norm += temp.sptr_shape->concentration;
-        
-        rve.sub_phases.insert(rve.sub_phases.begin()+i+num_phase_disc, temp);
+        alphas(i) = alpha;
         alpha += dalpha;
     }
+    vec concentrations = dalpha/6. * (pdf_rve.density(alphas-dalpha/2, true) + 4.*pdf_rve.density(alphas, true) + pdf_rve.density(alphas+dalpha/2, true));
     
     ///Normalization
-    for(int i=0; i<nb_phases_disc; i++) {
-        rve.sub_phases[i+num_phase_disc].sptr_shape->concentration *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / pdf_rve.norm);
+    pdf_rve.norm = sum(concentrations);
+    concentrations *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / pdf_rve.norm);
+    
+    //The phases are then built in a single pass: the other phases are moved, and the discretized phase is copied once per bin
+    std::vector<phase_characteristics> sub_phases;
+    sub_phases.reserve(rve.sub_phases.size() - 1 + nb_phases_disc);
+    for (int i=0; i<num_phase_disc; i++) {
+        sub_phases.push_back(std::move(rve.sub_phases[i]));
     }
+    for (int i=0; i<nb_phases_disc; i++) {
+        sub_phases.emplace_back();
+        sub_phases.back().copy(rve_init.sub_phases[num_phase_disc]);
+        fill_parameters(alphas(i), sub_phases.back(), pdf_rve);
+        sub_phases.back().sptr_shape->concentration = concentrations(i);
+    }
+    for (unsigned int i=num_phase_disc+1; i<rve.sub_phases.size(); i++) {
+        sub_phases.push_back(std::move(rve.sub_phases[i]));
+    }
+    rve.sub_phases = std::move(sub_phases);
     
     for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
-        rve.sub_phases[i].sptr_matprops->number = number;
-        number++;
+        rve.sub_phases[i].sptr_matprops->number = i;
     }
     
-//    cout << "rve = " << rve;
-    
     return rve;
     
 }
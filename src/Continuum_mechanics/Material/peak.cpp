@@ -194,6 +194,94 @@ double peak::get_density_PDF(const double &theta)
     }
 }
     
+//-------------------------------------------------------------
+vec peak::get_density_ODF(const vec &theta) const
+//-------------------------------------------------------------
+{
+    
+    switch (method) {
+        case 1: {
+            return ODF_sd(theta, mean, params);
+            break;
+        }
+        case 2: {
+            return ODF_hard(theta, mean, s_dev, ampl) + ODF_hard(theta - sim_pi, mean, s_dev, ampl) + ODF_hard(theta + sim_pi, mean, s_dev, ampl);
+            break;
+        }
+        case 3: {
+            return Gaussian(theta, mean, s_dev, ampl) + Gaussian(theta - sim_pi, mean, s_dev, ampl) + Gaussian(theta + sim_pi, mean, s_dev, ampl);
+            break;
+        }
+        case 4: {
+            return Lorentzian(theta, mean, width, ampl) + Lorentzian(theta - sim_pi, mean, width, ampl) + Lorentzian(theta + sim_pi, mean, width, ampl);
+            break;
+        }
+        case 5: {
+            return PseudoVoigt(theta, mean, s_dev, width, ampl, params) + PseudoVoigt(theta - sim_pi, mean, s_dev, width, ampl, params) + PseudoVoigt(theta + sim_pi, mean, s_dev, width, ampl, params);
+            break;
+        }
+        case 6: {
+            assert(width > 0.);
+            double inv_width = 1./width;
+            return Pearson7(theta, mean, inv_width, params) + Pearson7(theta - sim_pi, mean, inv_width, params) + Pearson7(theta + sim_pi, mean, inv_width, params);
+            break;
+        }
+        case 7: {
+            return ones(theta.n_elem);
+            break;
+        }
+        default : {
+            cout << "Error: The peak type specified is not recognized" << endl;
+            return zeros(theta.n_elem);
+            break;
+        }
+    }
+}
+
+//-------------------------------------------------------------
+vec peak::get_density_PDF(const vec &theta) const
+//-------------------------------------------------------------
+{
+    
+    switch (method) {
+        case 1: {
+            return ODF_sd(theta, mean, params);
+            break;
+        }
+        case 2: {
+            return ODF_hard(theta, mean, s_dev, ampl);
+            break;
+        }
+        case 3: {
+            return Gaussian(theta, mean, s_dev, ampl);
+            break;
+        }
+        case 4: {
+            return Lorentzian(theta, mean, width, ampl);
+            break;
+        }
+        case 5: {
+            return PseudoVoigt(theta, mean, s_dev, width, ampl, params);
+            break;
+        }
+        case 6: {
+            assert(width > 0.);
+            double inv_width = 1./width;
+            return Pearson7(theta, mean, inv_width, params);
+            break;
+        }
+        case 7: {
+            return ones(theta.n_elem);
+            break;
+        }
+        default : {
+            cout << "Error: The peak type specified is not recognized" << endl;
+            return zeros(theta.n_elem);
+            break;
+        }
+    }
+}
+    
 //----------------------------------------------------------------------
 peak& peak::operator = (const peak& pc)
 //----------------------------------------------------------------------
@@ -0,0 +1,297 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file texture.cpp
+///@brief Discretized texture shared by the material points of a polycrystal
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include <mutex>
+#include <ctime>
+#include <assert.h>
+#include <armadillo>
+#include <boost/filesystem.hpp>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+#include <simcoon/Simulation/Phase/state_variables_T.hpp>
+#include <simcoon/Simulation/Geometry/layer.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
+#include <simcoon/Simulation/Geometry/cylinder.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/layer_multi.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/ellipsoid_multi.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/cylinder_multi.hpp>
+#include <simcoon/Continuum_mechanics/Material/ODF2Nphases.hpp>
+#include <simcoon/Continuum_mechanics/Material/read.hpp>
+#include <simcoon/Continuum_mechanics/Material/texture.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+//Textures read from files, with the modification times of the files they are built from
+struct shared_texture {
+    std::shared_ptr<const texture> tex;
+    std::time_t time_texture;
+    std::time_t time_peaks;
+};
+static std::map<string, shared_texture> shared_textures;
+static std::mutex shared_textures_mutex;
+
+static std::time_t file_time(const string &path) {
+    boost::system::error_code ec;
+    std::time_t t = boost::filesystem::last_write_time(path, ec);
+    return (ec) ? 0 : t;
+}
+
+//=====Private methods for texture===================================
+
+//=====Public methods for texture====================================
+
+/*!
+  \brief default constructor
+*/
+
+//-------------------------------------------------------------
+texture::texture()
+//-------------------------------------------------------------
+{
+    num_phase_disc = 0;
+}
+
+/*!
+  \brief Constructor from the discretization of a phase of an rve with an ODF
+  \param rve_init rve whose sub_phases are read
+  \param mnum_phase_disc index of the phase to discretize
+  \param odf_rve ODF, whose peaks are read
+  \param nb_phases_disc number of orientations
+  \param angles_mat 1 if the material coordinate system follows the orientation, 0 if only the geometry does
+*/
+
+//-------------------------------------------------------------
+texture::texture(const phase_characteristics &rve_init, const int &mnum_phase_disc, ODF &odf_rve, const int &nb_phases_disc, const int &angles_mat)
+//-------------------------------------------------------------
+{
+    num_phase_disc = mnum_phase_disc;
+    grain.copy(rve_init.sub_phases[num_phase_disc]);
+    
+    phase_characteristics rve = discretize_ODF(rve_init, odf_rve, num_phase_disc, nb_phases_disc, angles_mat);
+    
+    weights = zeros(nb_phases_disc);
+    matprops.resize(nb_phases_disc);
+    shapes.resize(nb_phases_disc);
+    for (int i=0; i<nb_phases_disc; i++) {
+        phase_characteristics &r = rve.sub_phases[num_phase_disc + i];
+        weights(i) = r.sptr_shape->concentration;
+        matprops[i] = r.sptr_matprops;
+        shapes[i] = r.sptr_shape;
+    }
+}
+
+/*!
+  \brief Copy constructor
+  \param s texture object to duplicate (the material properties and the geometries remain shared)
+*/
+
+//------------------------------------------------------
+texture::texture(const texture& tx)
+//------------------------------------------------------
+{
+    num_phase_disc = tx.num_phase_disc;
+    peak_file = tx.peak_file;
+    weights = tx.weights;
+    grain.copy(tx.grain);
+    matprops = tx.matprops;
+    shapes = tx.shapes;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+texture::~texture() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+unsigned int texture::size() const
+//-------------------------------------------------------------
+{
+    return matprops.size();
+}
+
+//-------------------------------------------------------------
+void texture::build(phase_characteristics &rve) const
+//-------------------------------------------------------------
+{
+    assert(num_phase_disc < int(rve.sub_phases.size()));
+    
+    std::vector<phase_characteristics> sub_phases;
+    sub_phases.reserve(rve.sub_phases.size() - 1 + size());
+    for (int i=0; i<num_phase_disc; i++) {
+        sub_phases.push_back(std::move(rve.sub_phases[i]));
+    }
+    
+    for (unsigned int i=0; i<size(); i++) {
+        
+        std::shared_ptr<phase_multi> sptr_multi;
+        switch (grain.shape_type) {
+            case 0: {
+                sptr_multi = std::make_shared<phase_multi>(*grain.sptr_multi);
+                break;
+            }
+            case 1: {
+                sptr_multi = std::make_shared<layer_multi>(*std::dynamic_pointer_cast<layer_multi>(grain.sptr_multi));
+                break;
+            }
+            case 2: {
+                sptr_multi = std::make_shared<ellipsoid_multi>(*std::dynamic_pointer_cast<ellipsoid_multi>(grain.sptr_multi));
+                break;
+            }
+            case 3: {
+                sptr_multi = std::make_shared<cylinder_multi>(*std::dynamic_pointer_cast<cylinder_multi>(grain.sptr_multi));
+                break;
+            }
+        }
+        
+        std::shared_ptr<state_variables> sptr_sv_global;
+        std::shared_ptr<state_variables> sptr_sv_local;
+        switch (grain.sv_type) {
+            case 1: {
+                sptr_sv_global = std::make_shared<state_variables_M>(*std::dynamic_pointer_cast<state_variables_M>(grain.sptr_sv_global));
+                sptr_sv_local = std::make_shared<state_variables_M>(*std::dynamic_pointer_cast<state_variables_M>(grain.sptr_sv_local));
+                break;
+            }
+            case 2: {
+                sptr_sv_global = std::make_shared<state_variables_T>(*std::dynamic_pointer_cast<state_variables_T>(grain.sptr_sv_global));
+                sptr_sv_local = std::make_shared<state_variables_T>(*std::dynamic_pointer_cast<state_variables_T>(grain.sptr_sv_local));
+                break;
+            }
+            default: {
+                sptr_sv_global = std::make_shared<state_variables>(*grain.sptr_sv_global);
+                sptr_sv_local = std::make_shared<state_variables>(*grain.sptr_sv_local);
+                break;
+            }
+        }
+        //The orientations take the temperature of the material point
+        sptr_sv_global->T = rve.sptr_sv_global->T;
+        sptr_sv_local->T = rve.sptr_sv_global->T;
+        
+        sub_phases.emplace_back(grain.shape_type, grain.sv_type, shapes[i], sptr_multi, matprops[i], sptr_sv_global, sptr_sv_local, nullptr, nullptr, grain.sub_phases_file);
+        
+        phase_characteristics &g = sub_phases.back();
+        g.sub_phases.reserve(grain.sub_phases.size());
+        for (const auto &r : grain.sub_phases) {
+            g.sub_phases.emplace_back();
+            g.sub_phases.back().copy(r);
+        }
+    }
+    
+    for (unsigned int i=num_phase_disc+1; i<rve.sub_phases.size(); i++) {
+        sub_phases.push_back(std::move(rve.sub_phases[i]));
+    }
+    rve.sub_phases = std::move(sub_phases);
+    
+    //The phases are renumbered as in discretize_ODF. The orientations already carry their number, and their shared material properties are left untouched
+    for (int i=0; i<num_phase_disc; i++) {
+        rve.sub_phases[i].sptr_matprops->number = i;
+    }
+    for (unsigned int i=num_phase_disc+size(); i<rve.sub_phases.size(); i++) {
+        rve.sub_phases[i].sptr_matprops->number = i;
+    }
+}
+
+//-------------------------------------------------------------
+std::shared_ptr<const texture> texture::shared(const phase_characteristics &rve, const string &path_data, const string &inputfile)
+//-------------------------------------------------------------
+{
+    string path_inputfile = path_data + "/" + inputfile;
+    std::lock_guard<std::mutex> lock(shared_textures_mutex);
+    
+    std::time_t time_texture = file_time(path_inputfile);
+    auto it = shared_textures.find(path_inputfile);
+    if ((it != shared_textures.end())&&(it->second.time_texture == time_texture)) {
+        if ((!it->second.tex)||(it->second.time_peaks == file_time(path_data + "/" + it->second.tex->peak_file)))
+            return it->second.tex;
+    }
+    
+    shared_texture st;
+    st.time_texture = time_texture;
+    st.time_peaks = 0;
+    
+    //Number Nphases Angle angle_min angle_max angles_mat peaks (the angles are in degrees)
+    std::ifstream paramtexture(path_inputfile, ios::in);
+    string buffer;
+    int number = 0;
+    int nphases = 0;
+    int Angle = 0;
+    double angle_min = 0.;
+    double angle_max = 180.;
+    int angles_mat = 1;
+    string peakfile;
+    if ((!paramtexture)||(!getline(paramtexture, buffer))||(!(paramtexture >> number >> nphases >> Angle >> angle_min >> angle_max >> angles_mat >> peakfile))) {
+        shared_textures[path_inputfile] = st;
+        return nullptr;
+    }
+    
+    if (number >= int(rve.sub_phases.size())) {
+        cout << "Error: the phase " << number << " to discretize with the texture " << inputfile << " does not exist\n";
+        shared_textures[path_inputfile] = st;
+        return nullptr;
+    }
+    
+    ODF odf_rve(Angle, false, angle_min, angle_max);
+    read_peak(odf_rve, path_data, peakfile);
+    
+    auto tex = std::make_shared<texture>(rve, number, odf_rve, nphases, angles_mat);
+    tex->peak_file = peakfile;
+    st.tex = tex;
+    st.time_peaks = file_time(path_data + "/" + peakfile);
+    shared_textures[path_inputfile] = st;
+    return st.tex;
+}
+
+//----------------------------------------------------------------------
+texture& texture::operator = (const texture& tx)
+//----------------------------------------------------------------------
+{
+    num_phase_disc = tx.num_phase_disc;
+    peak_file = tx.peak_file;
+    weights = tx.weights;
+    grain.copy(tx.grain);
+    matprops = tx.matprops;
+    shapes = tx.shapes;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const texture& tx)
+//--------------------------------------------------------------------------
+{
+    s << "Display texture:\n";
+    s << "Discretized phase: " << tx.num_phase_disc << "\n";
+    s << "Number of orientations: " << tx.size() << "\n";
+    s << "Weights:\n" << tx.weights.t() << "\n";
+    
+    return s;
+}
+
+} //namespace simcoon
@@ -0,0 +1,394 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file L_eff_table.cpp
+///@brief Tabulated effective stiffness of a microstructure of ellipsoidal phases over a grid of parameters, evaluated by multilinear interpolation
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <assert.h>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
+#include <simcoon/Continuum_mechanics/Umat/umat_L_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/L_eff_table.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+//Tables loaded from files, shared by all the material points that use them
+static std::map<string, std::shared_ptr<const L_eff_table> > shared_tables;
+static std::mutex shared_tables_mutex;
+
+//=====Private methods for L_eff_table===================================
+
+//=====Public methods for L_eff_table====================================
+
+/*!
+  \brief default constructor
+*/
+
+//-------------------------------------------------------------
+L_eff_table::L_eff_table() : error(2)
+//-------------------------------------------------------------
+{
+    error.zeros();
+}
+
+/*!
+  \brief Constructor with the axes of the grid
+*/
+
+//-------------------------------------------------------------
+L_eff_table::L_eff_table(const umat &mparameters, const std::vector<vec> &maxes) : error(2)
+//-------------------------------------------------------------
+{
+    assert(mparameters.n_rows == maxes.size());
+    parameters = mparameters;
+    axes = maxes;
+    table = zeros(36, size());
+    error.zeros();
+}
+
+/*!
+  \brief Copy constructor
+  \param s L_eff_table object to duplicate
+*/
+
+//------------------------------------------------------
+L_eff_table::L_eff_table(const L_eff_table& lt)
+//------------------------------------------------------
+{
+    parameters = lt.parameters;
+    axes = lt.axes;
+    table = lt.table;
+    error = lt.error;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+L_eff_table::~L_eff_table() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+unsigned int L_eff_table::size() const
+//-------------------------------------------------------------
+{
+    unsigned int nnodes = 1;
+    for (const auto &a : axes) {
+        nnodes *= a.n_elem;
+    }
+    return nnodes;
+}
+
+//-------------------------------------------------------------
+uvec L_eff_table::node(const unsigned int &n) const
+//-------------------------------------------------------------
+{
+    uvec k = zeros<uvec>(axes.size());
+    unsigned int m = n;
+    for (unsigned int d=0; d<axes.size(); d++) {
+        k(d) = m % axes[d].n_elem;
+        m /= axes[d].n_elem;
+    }
+    return k;
+}
+
+//-------------------------------------------------------------
+void L_eff_table::build(const phase_characteristics &rve, const unsigned int &nerror)
+//-------------------------------------------------------------
+{
+    unsigned int naxes = axes.size();
+    unsigned int nnodes = size();
+    
+    mat points = zeros(naxes, nnodes);
+    for (unsigned int n=0; n<nnodes; n++) {
+        uvec k = node(n);
+        for (unsigned int d=0; d<naxes; d++) {
+            points(d,n) = axes[d](k(d));
+        }
+    }
+    
+    std::vector<mat> L = L_eff_variants(rve, parameters, points);
+    if (L.size() != nnodes)
+        return;
+    
+    table = zeros(36, nnodes);
+    for (unsigned int n=0; n<nnodes; n++) {
+        table.col(n) = vectorise(L[n]);
+    }
+    
+    //The error of the interpolation is the largest at the centers of the cells
+    error.zeros();
+    if (nerror == 0)
+        return;
+    
+    mat centers = zeros(naxes, nerror);
+    for (unsigned int e=0; e<nerror; e++) {
+        vec u = randu(naxes);
+        for (unsigned int d=0; d<naxes; d++) {
+            unsigned int n_d = axes[d].n_elem;
+            if (n_d == 1) {
+                centers(d,e) = axes[d](0);
+                continue;
+            }
+            unsigned int k = std::min(n_d-2, (unsigned int)(u(d)*(n_d-1)));
+            centers(d,e) = 0.5*(axes[d](k) + axes[d](k+1));
+        }
+    }
+    
+    std::vector<mat> L_centers = L_eff_variants(rve, parameters, centers);
+    vec rel = zeros(L_centers.size());
+    for (unsigned int e=0; e<L_centers.size(); e++) {
+        rel(e) = norm(interpolate(centers.col(e)) - L_centers[e],"fro")/norm(L_centers[e],"fro");
+    }
+    if (rel.n_elem > 0) {
+        error(0) = rel.max();
+        error(1) = sqrt(mean(square(rel)));
+    }
+}
+
+//-------------------------------------------------------------
+mat L_eff_table::interpolate(const vec &x) const
+//-------------------------------------------------------------
+{
+    unsigned int naxes = axes.size();
+    assert(x.n_elem >= naxes);
+    
+    //Cell of the point along each axis, and its relative position in the cell
+    uvec k = zeros<uvec>(naxes);
+    vec t = zeros(naxes);
+    uvec stride = ones<uvec>(naxes);
+    for (unsigned int d=0; d<naxes; d++) {
+        if (d > 0)
+            stride(d) = stride(d-1)*axes[d-1].n_elem;
+        
+        unsigned int n_d = axes[d].n_elem;
+        if (n_d == 1)
+            continue;
+        
+        double x_d = std::min(std::max(x(d), axes[d](0)), axes[d](n_d-1));
+        const double *it = std::upper_bound(axes[d].memptr(), axes[d].memptr() + n_d, x_d);
+        k(d) = std::min((unsigned int)(it - axes[d].memptr()), n_d-1) - 1;
+        t(d) = (x_d - axes[d](k(d)))/(axes[d](k(d)+1) - axes[d](k(d)));
+    }
+    
+    //Multilinear combination of the 2^naxes corners of the cell
+    vec L = zeros(36);
+    for (unsigned int c=0; c<(1u << naxes); c++) {
+        double weight = 1.;
+        unsigned int n = 0;
+        for (unsigned int d=0; d<naxes; d++) {
+            unsigned int b = (c >> d) & 1u;
+            if ((b == 1)&&(axes[d].n_elem == 1)) {
+                weight = 0.;
+                break;
+            }
+            weight *= (b == 1) ? t(d) : 1. - t(d);
+            n += (k(d) + b)*stride(d);
+        }
+        if (weight > 0.)
+            L += weight*table.col(n);
+    }
+    return reshape(L, 6, 6);
+}
+
+//-------------------------------------------------------------
+bool L_eff_table::save(const string &filename) const
+//-------------------------------------------------------------
+{
+    std::ofstream file(filename, ios::binary);
+    if (!file)
+        return false;
+    
+    file << "SIMCOON_L_EFF_TABLE\n";
+    bool ok = parameters.save(file, arma_binary);
+    for (const auto &a : axes) {
+        ok = ok && a.save(file, arma_binary);
+    }
+    ok = ok && table.save(file, arma_binary);
+    ok = ok && error.save(file, arma_binary);
+    return ok;
+}
+
+//-------------------------------------------------------------
+bool L_eff_table::load(const string &filename)
+//-------------------------------------------------------------
+{
+    std::ifstream file(filename, ios::binary);
+    string header;
+    if ((!file)||(!getline(file, header))||(header != "SIMCOON_L_EFF_TABLE"))
+        return false;
+    
+    bool ok = parameters.load(file, arma_binary);
+    axes.resize(parameters.n_rows);
+    for (auto &a : axes) {
+        ok = ok && a.load(file, arma_binary);
+    }
+    ok = ok && table.load(file, arma_binary);
+    ok = ok && error.load(file, arma_binary);
+    return ((ok)&&(table.n_rows == 36)&&(table.n_cols == size()));
+}
+
+//-------------------------------------------------------------
+std::shared_ptr<const L_eff_table> L_eff_table::shared(const string &filename)
+//-------------------------------------------------------------
+{
+    std::lock_guard<std::mutex> lock(shared_tables_mutex);
+    auto it = shared_tables.find(filename);
+    if (it != shared_tables.end())
+        return it->second;
+    
+    auto lt = std::make_shared<L_eff_table>();
+    if (!lt->load(filename))
+        return nullptr;
+    
+    shared_tables[filename] = lt;
+    return lt;
+}
+
+//----------------------------------------------------------------------
+L_eff_table& L_eff_table::operator = (const L_eff_table& lt)
+//----------------------------------------------------------------------
+{
+    parameters = lt.parameters;
+    axes = lt.axes;
+    table = lt.table;
+    error = lt.error;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const L_eff_table& lt)
+//--------------------------------------------------------------------------
+{
+    s << "Display L_eff table:\n";
+    for (unsigned int d=0; d<lt.axes.size(); d++) {
+        s << "Axis " << d << ": phase " << lt.parameters(d,0) << ", parameter " << lt.parameters(d,1) << ", " << lt.axes[d].n_elem << " values from " << lt.axes[d].min() << " to " << lt.axes[d].max() << "\n";
+    }
+    s << "Number of nodes: " << lt.size() << "\n";
+    s << "Relative error of the interpolation (maximum, rms): " << lt.error.t() << "\n";
+    
+    return s;
+}
+
+std::vector<mat> L_eff_variants(const phase_characteristics &rve, const umat &parameters, const mat &points) {
+    
+    static const std::map<string, int> list_umat = {{"MIHEN",100},{"MIMTN",101},{"MISCN",103}};
+    auto it_umat = list_umat.find(rve.sptr_matprops->umat_name);
+    if (it_umat == list_umat.end()) {
+        cout << "Error: the effective stiffness can be tabulated for the micromechanical schemes of ellipsoidal phases only (MIHEN, MIMTN, MISCN)\n";
+        return std::vector<mat>();
+    }
+    
+    unsigned int nphases = rve.sub_phases.size();
+    unsigned int nvariants = points.n_cols;
+    int n_matrix = (rve.sptr_matprops->nprops > 4) ? int(rve.sptr_matprops->props(4)) : 0;
+    
+    int mp = rve.sptr_matprops->props(2);
+    int np = rve.sptr_matprops->props(3);
+    vec x = zeros(mp);
+    vec wx = zeros(mp);
+    vec y = zeros(np);
+    vec wy = zeros(np);
+    simcoon::points(x, wx, y, wy, mp, np);
+    mat xi;
+    vec w;
+    directions(xi, w, x, wx, y, wy, mp, np);
+    
+    //Stiffness and shape of the phases of the rve, in the coordinate system of the rve
+    std::vector<mat> L_base(nphases);
+    std::vector<ellipsoid> ell_base(nphases);
+    for (unsigned int i=0; i<nphases; i++) {
+        L_base[i] = std::dynamic_pointer_cast<state_variables_M>(rve.sub_phases[i].sptr_sv_global)->Lt;
+        ell_base[i] = *std::dynamic_pointer_cast<ellipsoid>(rve.sub_phases[i].sptr_shape);
+    }
+    
+    uvec axes_phase = parameters.col(0);
+    uvec axes_code = parameters.col(1);
+    bool concentration = (uvec(find(axes_code == 0)).n_elem > 0);
+    uvec props_phases = unique(axes_phase.elem(find(axes_code >= 10)));
+    
+    std::vector<std::vector<mat> > L(nvariants, L_base);
+    std::vector<std::vector<ellipsoid> > ell(nvariants, ell_base);
+    for (unsigned int v=0; v<nvariants; v++) {
+        for (unsigned int a=0; a<parameters.n_rows; a++) {
+            unsigned int p = parameters(a,0);
+            assert(p < nphases);
+            switch (parameters(a,1)) {
+                case 0: {
+                    ell[v][p].concentration = points(a,v);
+                    break;
+                }
+                case 1: {
+                    ell[v][p].a1 = points(a,v);
+                    break;
+                }
+                case 2: {
+                    ell[v][p].a2 = points(a,v);
+                    break;
+                }
+                case 3: {
+                    ell[v][p].a3 = points(a,v);
+                    break;
+                }
+                default: break;
+            }
+        }
+        
+        //The phases with material parameters on the grid have their stiffness recomputed
+        for (unsigned int p : props_phases) {
+            phase_characteristics temp;
+            temp.copy(rve.sub_phases[p]);
+            for (unsigned int a=0; a<parameters.n_rows; a++) {
+                if ((parameters(a,0) == p)&&(parameters(a,1) >= 10))
+                    temp.sptr_matprops->props(parameters(a,1) - 10) = points(a,v);
+            }
+            get_L_elastic(temp);
+            L[v][p] = std::dynamic_pointer_cast<state_variables_M>(temp.sptr_sv_global)->Lt;
+        }
+        
+        //The matrix phase takes the remaining volume fraction
+        if (concentration) {
+            double c_m = 1.;
+            for (unsigned int p=0; p<nphases; p++) {
+                if ((int)p != n_matrix)
+                    c_m -= ell[v][p].concentration;
+            }
+            ell[v][n_matrix].concentration = c_m;
+        }
+    }
+    
+    return L_eff_batch(L, ell, it_umat->second, n_matrix, xi, w);
+}
+
+} //namespace simcoon
@@ -22,10 +22,13 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <assert.h>
 #include <armadillo>
 #include <memory>
 #include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/parallel.hpp>
+#include <simcoon/Simulation/Maths/num_solve.hpp>
 #include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
 #include <simcoon/Continuum_mechanics/Micromechanics/multiphase.hpp>
 #include <simcoon/Continuum_mechanics/Umat/umat_smart.hpp>
@@ -34,6 +37,10 @@
 #include <simcoon/Continuum_mechanics/Homogenization/ellipsoid_multi.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
 #include <simcoon/Continuum_mechanics/Micromechanics/schemes.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_fft.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/voxel_multi.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/L_eff_table.hpp>
+#include <simcoon/Continuum_mechanics/Material/texture.hpp>
 
 using namespace std;
 using namespace arma;
@@ -48,10 +55,9 @@ namespace simcoon{
 
 ///@brief The table Nphases.dat will store the necessary informations about the geometry of the phases and the material properties
 
-void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, bool &start, const unsigned int &solver_type, double &tnew_dt, const int &method)
+int umat_multi(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, bool &start, const unsigned int &solver_type, double &tnew_dt, const int &method, const bool &warm_start, const bool &use_texture)
 {
 
-    int nphases = phase.sptr_matprops->props(0); // Number of phases
     string path_data = "data";
     string inputfile; //file # that stores the microstructure properties
     
@@ -64,13 +70,7 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
                 
             case 100: case 101: case 102: case 103: {
                 //Definition of the static vectors x,wx,y,wy
-                ellipsoid_multi::mp = phase.sptr_matprops->props(2);
-                ellipsoid_multi::np = phase.sptr_matprops->props(3);
-                ellipsoid_multi::x.set_size(ellipsoid_multi::mp);
-                ellipsoid_multi::wx.set_size(ellipsoid_multi::mp);
-                ellipsoid_multi::y.set_size(ellipsoid_multi::np);
-                ellipsoid_multi::wy.set_size(ellipsoid_multi::np);
-                points(ellipsoid_multi::x, ellipsoid_multi::wx, ellipsoid_multi::y, ellipsoid_multi::wy,ellipsoid_multi::mp, ellipsoid_multi::np);
+                ellipsoid_multi::set_quadrature(phase.sptr_matprops->props(2), phase.sptr_matprops->props(3));
                 
                 inputfile = "Nellipsoids" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
                 read_ellipsoid(phase, path_data, inputfile);
@@ -82,8 +82,22 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
                 break;
             }
         }
+        
+        //A texture file discretizes one phase into orientations, whose material properties and geometry are shared by all the material points.
+        //It is looked up once per material point, and kept by the phase
+        if (use_texture) {
+            if (!phase.texture_read) {
+                inputfile = "Ntexture" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
+                phase.sptr_texture = texture::shared(phase, path_data, inputfile);
+                phase.texture_read = true;
+            }
+            if (phase.sptr_texture)
+                phase.sptr_texture->build(phase);
+        }
     }
     
+    int nphases = phase.sub_phases.size(); // Number of phases
+    
 	//Initialization
 	if (start) {
         
@@ -96,14 +110,33 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
     // Preliminaries of the convergence loop
     int nbiter = 0;
     double error = 1.;
+    double error_prev = 0.;
     std::vector<vec> DE_N(nphases); //Table that stores all the previous increments of strain
+    std::vector<vec> DE_G(nphases); //Table that stores the increments of strain given by the micromechanical scheme
+    
+    //Anderson acceleration of the localization: history of the stacked phase strain increments
+    bool anderson = (depth_anderson_micro > 0);
+    vec x_k = zeros(6*nphases);
+    vec g_k = zeros(6*nphases);
+    vec g_prev;
+    vec f_prev;
+    mat dG;
+    mat dF;
+    
+    //Warm start: the strain increments of the phases are predicted from the concentration tensors of the last call (kept in the phase state),
+    //instead of their last increments. The first pass of the scheme is accepted if it matches the prediction
+    double norm_DE = norm(umat_phase_M->DEtot,2);
+    if ((warm_start)&&(!start)) {
+        for(int i=0; i<nphases; i++) {
+            phase.sub_phases[i].sptr_sv_global->DEtot = phase.sub_phases[i].sptr_multi->A*umat_phase_M->DEtot + norm_DE*phase.sub_phases[i].sptr_multi->DE_corr;
+        }
+    }
     
 	//Convergence loop, localization
 	while ((error > precision_micro)&&(nbiter <= maxiter_micro)) {
 	  
         for(int i=0; i<nphases; i++) {
-            auto sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
-            DE_N[i] = sv_r->DEtot;
+            DE_N[i] = phase.sub_phases[i].sptr_sv_global->DEtot;
         }
 
         //Compute the strain concentration tensor for each phase:
@@ -135,25 +168,61 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
             }
         
         }
+        
+        for(int i=0; i<nphases; i++) {
+            DE_G[i] = phase.sub_phases[i].sptr_sv_global->DEtot;
+        }
+        
+        //The next strain increments are a combination of the previous ones (type-II Anderson mixing)
+        if (anderson) {
+            for(int i=0; i<nphases; i++) {
+                x_k.subvec(6*i, 6*i+5) = DE_N[i];
+                g_k.subvec(6*i, 6*i+5) = DE_G[i];
+            }
+            vec x_new = Anderson_mixing(x_k, g_k, dG, dF, g_prev, f_prev, depth_anderson_micro);
+            for(int i=0; i<nphases; i++) {
+                phase.sub_phases[i].sptr_sv_global->DEtot = x_new.subvec(6*i, 6*i+5);
+            }
+        }
     
-        for (unsigned int i=0; i<phase.sub_phases.size(); i++) {
-            phase.sub_phases[i].sptr_sv_global->to_start();
-            
-            //Theta method for the tangent modulus
-            //mat Lt_start = umat_sub_phases_M->Lt
-            select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+        //The phases are independent once their strain increment is known: they are evaluated concurrently for large RVEs.
+        //The first increment (start) is kept sequential, since it (re)defines the shared integration points of the sub-RVEs
+        if ((!start)&&(nphases >= nphases_parallel_micro)) {
+            vec tnew_dt_r = tnew_dt*ones(nphases);
+            parallel_for(nphases, [&](const unsigned int &i) {
+                phase.sub_phases[i].sptr_sv_global->to_start();
+                select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt_r(i));
+            });
+            tnew_dt = tnew_dt_r.min();
+        }
+        else {
+            for (unsigned int i=0; i<phase.sub_phases.size(); i++) {
+                phase.sub_phases[i].sptr_sv_global->to_start();
+                
+                //Theta method for the tangent modulus
+                //mat Lt_start = umat_sub_phases_M->Lt
+                select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
 
-            //Theta method for the tangent modulus
-            //umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-            //Lt* = (1 - (2./3.))*Lt_start + 2./3.*Lt;
+                //Theta method for the tangent modulus
+                //umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+                //Lt* = (1 - (2./3.))*Lt_start + 2./3.*Lt;
+            }
         }
         
         error = 0.;
         for(int i=0; i<nphases; i++) {
-            auto sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
-            error += norm(DE_N[i] - sv_r->DEtot,2);
+            error += norm(DE_N[i] - DE_G[i],2);
         }
         error*=(1./nphases);
+        
+        //The Anderson history is restarted if the residual increases: the next iterate is a plain fixed-point one
+        if ((anderson)&&(nbiter > 0)&&((error > error_prev)||(!std::isfinite(error)))) {
+            dG.reset();
+            dF.reset();
+            g_prev.reset();
+            f_prev.reset();
+        }
+        error_prev = error;
         nbiter++;
 	}
     
@@ -176,6 +245,7 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
             }
             case 103: {
                 int n_matrix = phase.sptr_matprops->props(4);
+                //A single sweep per call: the reference medium converges along the increments (the Broyden solver is for the elastic estimate only)
                 Lt_Self_Consistent(phase, n_matrix, start, phase.sptr_matprops->props(5));
                 break;
             }
@@ -186,20 +256,274 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
             
     }
     
+    //Part of the phase strain increments that is not predicted by the concentration tensors, for the warm start of the next call
+    if (warm_start) {
+        for (auto &r : phase.sub_phases) {
+            if (norm_DE > sim_iota)
+                r.sptr_multi->DE_corr = (r.sptr_sv_global->DEtot - r.sptr_multi->A*umat_phase_M->DEtot)/norm_DE;
+            else
+                r.sptr_multi->DE_corr = zeros(6);
+        }
+    }
+    
     //	Homogenization
 	//Compute the effective stress
 	umat_phase_M->sigma = zeros(6);
-    for (auto r : phase.sub_phases) {
+    for (auto &r : phase.sub_phases) {
 		umat_phase_M->sigma += r.sptr_shape->concentration*r.sptr_sv_global->sigma;
 	}
     
     umat_phase_M->Lt = zeros(6,6);
 	// Compute the effective tangent modulus, and the effective stress
-    for (auto r : phase.sub_phases) {
+    for (auto &r : phase.sub_phases) {
         umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
 		umat_phase_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
 	}
     
+    return nbiter;
+}
+
+///@brief The TFA UMAT requires the same 5 constants as the Mori-Tanaka UMAT (MIMTN):
+///@brief props[0] : Number of phases
+///@brief props[1] : File # that stores the microstructure properties
+///@brief props[2] : Number of integration points in the 1 direction
+///@brief props[3] : Number of integration points in the 2 direction
+///@brief props[4] : Number of the matrix phase
+
+///@brief The elastic concentration tensors A and influence tensors D_in are computed once, at the first call.
+///@brief The strain increment of each phase then solves DE_r = A_r*DE + sum_s D_in[s]*Dmu_s, where the inelastic strain increment
+///@brief Dmu_s = DE_s - M_s*Dsigma_s is given by the constitutive model of the phase: no concentration tensor is recomputed
+
+void umat_multi_TFA(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, bool &start, const unsigned int &solver_type, double &tnew_dt)
+{
+    
+    int nphases = phase.sptr_matprops->props(0); // Number of phases
+    int n_matrix = phase.sptr_matprops->props(4);
+    string path_data = "data";
+    string inputfile; //file # that stores the microstructure properties
+    
+    shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local); //shared_ptr on state variables of the rve
+    shared_ptr<state_variables_M> umat_sub_phases_M; //shared_ptr on state variables
+    
+    //Initialization: the phases are read, and the tensors of the reduced-order model are computed from their elastic stiffnesses
+    if (start) {
+        //Definition of the static vectors x,wx,y,wy
+        ellipsoid_multi::set_quadrature(phase.sptr_matprops->props(2), phase.sptr_matprops->props(3));
+        
+        inputfile = "Nellipsoids" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
+        read_ellipsoid(phase, path_data, inputfile);
+        
+        std::vector<mat> L(nphases);
+        for (int i=0; i<nphases; i++) {
+            select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+            
+            //The constitutive models that do not provide their elastic stiffness are represented by their initial tangent modulus
+            umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+            L[i] = (norm(umat_sub_phases_M->L,"fro") > sim_iota) ? umat_sub_phases_M->L : umat_sub_phases_M->Lt;
+            phase.sub_phases[i].sptr_multi->M_in = inv(L[i]);
+        }
+        TFA_Mori_Tanaka(phase, n_matrix, L);
+    }
+    
+    //Stacked concentration and influence tensors of the phases
+    mat A_N = zeros(6*nphases, 6);
+    mat D_N = zeros(6*nphases, 6*nphases);
+    for (int i=0; i<nphases; i++) {
+        A_N.rows(6*i, 6*i+5) = phase.sub_phases[i].sptr_multi->A;
+        for (int j=0; j<nphases; j++) {
+            D_N.submat(6*i, 6*j, 6*i+5, 6*j+5) = phase.sub_phases[i].sptr_multi->D_in[j];
+        }
+    }
+    
+    //The first iterate is the elastic localization of the strain increment
+    vec DE_N = A_N*umat_phase_M->DEtot;
+    vec Dmu_N = zeros(6*nphases);
+    vec R_N = zeros(6*nphases);
+    mat J_N = eye(6*nphases, 6*nphases);
+    mat dmu_N = zeros(6*nphases, 6*nphases);
+    
+    int nbiter = 0;
+    double error = 1.;
+    
+    //Newton iterations on the stacked strain increments of the phases: R = DE_N - A_N*DE - D_N*Dmu_N(DE_N)
+    while ((error > precision_micro)&&(nbiter <= maxiter_micro)) {
+        
+        for (int i=0; i<nphases; i++) {
+            phase.sub_phases[i].sptr_sv_global->DEtot = DE_N.subvec(6*i, 6*i+5);
+        }
+        
+        //The phases are independent once their strain increment is known: they are evaluated concurrently for large RVEs.
+        if ((!start)&&(nphases >= nphases_parallel_micro)) {
+            vec tnew_dt_r = tnew_dt*ones(nphases);
+            parallel_for(nphases, [&](const unsigned int &i) {
+                phase.sub_phases[i].sptr_sv_global->to_start();
+                select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt_r(i));
+            });
+            tnew_dt = tnew_dt_r.min();
+        }
+        else {
+            for (auto &r : phase.sub_phases) {
+                r.sptr_sv_global->to_start();
+                select_umat_M(r, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+            }
+        }
+        
+        //Inelastic strain increments of the phases, and their derivative w.r.t. the strain increments
+        for (int i=0; i<nphases; i++) {
+            umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+            const mat &M_in = phase.sub_phases[i].sptr_multi->M_in;
+            Dmu_N.subvec(6*i, 6*i+5) = umat_sub_phases_M->DEtot - M_in*(umat_sub_phases_M->sigma - umat_sub_phases_M->sigma_start);
+            dmu_N.submat(6*i, 6*i, 6*i+5, 6*i+5) = eye(6,6) - M_in*umat_sub_phases_M->Lt;
+        }
+        
+        R_N = DE_N - A_N*umat_phase_M->DEtot - D_N*Dmu_N;
+        J_N = eye(6*nphases, 6*nphases) - D_N*dmu_N;
+        
+        error = 0.;
+        for (int i=0; i<nphases; i++) {
+            error += norm(R_N.subvec(6*i, 6*i+5),2);
+        }
+        error*=(1./nphases);
+        
+        if (error > precision_micro)
+            DE_N -= solve(J_N, R_N);
+        nbiter++;
+    }
+    
+    //	Homogenization
+    //Compute the effective stress, and the effective tangent modulus from the tangent concentration tensors dDE_N/dDE
+    mat A_t = solve(J_N, A_N);
+    umat_phase_M->sigma = zeros(6);
+    umat_phase_M->Lt = zeros(6,6);
+    for (int i=0; i<nphases; i++) {
+        umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+        umat_phase_M->sigma += phase.sub_phases[i].sptr_shape->concentration*umat_sub_phases_M->sigma;
+        umat_phase_M->Lt += phase.sub_phases[i].sptr_shape->concentration*(umat_sub_phases_M->Lt*A_t.rows(6*i, 6*i+5));
+    }
 }
+    
+///@brief The FFT UMAT requires 4 constants:
+///@brief props[0] : Number of phases
+///@brief props[1] : File # that stores the phases (Nphases[i].dat) and the voxel grid (Nvoxels[i].dat)
+///@brief props[2] : Scheme (0 : basic scheme of Moulinec-Suquet, 1 : accelerated by Anderson mixing)
+///@brief props[3] : Effective tangent modulus (0 : average of the tangent moduli of the voxels, 1 : solution of the linearized full-field problems)
+
+///@brief Each voxel runs the constitutive model of its phase. The state variables of a phase are the averages over its voxels
 
+void umat_multi_FFT(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, bool &start, const unsigned int &solver_type, double &tnew_dt)
+{
+    
+    string path_data = "data";
+    string inputfile; //file # that stores the microstructure properties
+    int scheme = phase.sptr_matprops->props(2);
+    int tangent = phase.sptr_matprops->props(3);
+    
+    shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local); //shared_ptr on state variables of the rve
+    shared_ptr<state_variables_M> umat_sub_phases_M; //shared_ptr on state variables
+    shared_ptr<voxel_multi> vox;
+    
+    //Initialization: the phases are read and initialized by their constitutive model, then the grid is read (the voxels start from the state of their phase).
+    //The reference medium is defined from the elastic stiffnesses of the phases
+    if (start) {
+        inputfile = "Nphases" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
+        read_phase(phase, path_data, inputfile);
+        for (auto &r : phase.sub_phases) {
+            select_umat_M(r, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+        }
+        inputfile = "Nvoxels" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
+        read_voxels(phase, path_data, inputfile);
+        
+        std::vector<mat> L;
+        for (auto &r : phase.sub_phases) {
+            vox = std::dynamic_pointer_cast<voxel_multi>(r.sptr_multi);
+            //The constitutive models that do not provide their elastic stiffness are represented by their initial tangent modulus
+            if (vox->size() > 0) {
+                umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+                L.push_back((norm(umat_sub_phases_M->L,"fro") > sim_iota) ? umat_sub_phases_M->L : umat_sub_phases_M->Lt);
+            }
+        }
+        
+        double lambda_0 = 0.;
+        double mu_0 = 0.;
+        reference_medium_fft(lambda_0, mu_0, L);
+        for (auto &r : phase.sub_phases) {
+            vox = std::dynamic_pointer_cast<voxel_multi>(r.sptr_multi);
+            vox->lambda_0 = lambda_0;
+            vox->mu_0 = mu_0;
+        }
+    }
+    
+    DE_FFT(phase, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt, scheme);
+    
+    //	Homogenization
+    //The state variables of each phase are the averages over its voxels, and the effective stress is their average
+    umat_phase_M->sigma = zeros(6);
+    umat_phase_M->Lt = zeros(6,6);
+    for (auto &r : phase.sub_phases) {
+        vox = std::dynamic_pointer_cast<voxel_multi>(r.sptr_multi);
+        umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+        if (vox->size() > 0) {
+            umat_sub_phases_M->DEtot = mean(vox->DEtot,1);
+            umat_sub_phases_M->sigma = mean(vox->sigma,1);
+            umat_sub_phases_M->Lt = reshape(mean(vox->Lt,1), 6, 6);
+        }
+        else {
+            umat_sub_phases_M->DEtot = zeros(6);
+            umat_sub_phases_M->sigma = zeros(6);
+            umat_sub_phases_M->Lt = zeros(6,6);
+        }
+        r.global2local();
+        
+        umat_phase_M->sigma += r.sptr_shape->concentration*umat_sub_phases_M->sigma;
+        umat_phase_M->Lt += r.sptr_shape->concentration*umat_sub_phases_M->Lt;
+    }
+    
+    if (tangent == 1)
+        umat_phase_M->Lt = Lt_FFT(phase, scheme);
+}
+    
+void umat_multi_table(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, bool &start, const unsigned int &solver_type, double &tnew_dt)
+{
+    UNUSED(DR);
+    UNUSED(Time);
+    UNUSED(DTime);
+    UNUSED(nshr);
+    UNUSED(solver_type);
+    UNUSED(tnew_dt);
+    
+    string path_data = "data";
+    string inputfile = path_data + "/L_eff_table" + to_string(int(phase.sptr_matprops->props(0))) + ".bin";
+    
+    shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local); //shared_ptr on state variables of the rve
+    
+    //The table is read once, and shared by all the material points that use it
+    std::shared_ptr<const L_eff_table> lt = L_eff_table::shared(inputfile);
+    //The table does not record the microstructure it was built from: without it, there is no effective stiffness to fall back on
+    if (!lt) {
+        cout << "Error: The table of effective stiffness " << inputfile << " could not be read\n";
+        throw std::runtime_error("umat_multi_table: the table of effective stiffness " + inputfile + " could not be read");
+    }
+    
+    const vec &props = phase.sptr_matprops->props;
+    umat_phase_M->L = lt->interpolate(props.tail(props.n_elem - 1));
+    umat_phase_M->Lt = umat_phase_M->L;
+    
+    if (start) {
+        umat_phase_M->sigma = zeros(6);
+        umat_phase_M->Wm = zeros(4);
+    }
+    
+    vec sigma_start = umat_phase_M->sigma;
+    umat_phase_M->sigma = el_pred(umat_phase_M->L, umat_phase_M->Etot + umat_phase_M->DEtot, ndi);
+    umat_phase_M->sigma_in = zeros(6);
+    
+    //Work of the increment (trapezoidal rule), and variation of the stored elastic energy; the difference is dissipated (zero up to round-off for the symmetric L)
+    double DWm = 0.5*sum((sigma_start + umat_phase_M->sigma)%umat_phase_M->DEtot);
+    double DWm_r = 0.5*sum(umat_phase_M->sigma%(umat_phase_M->Etot + umat_phase_M->DEtot)) - 0.5*sum(sigma_start%umat_phase_M->Etot);
+    umat_phase_M->Wm(0) += DWm;
+    umat_phase_M->Wm(1) += DWm_r;
+    umat_phase_M->Wm(2) += 0.;
+    umat_phase_M->Wm(3) += DWm - DWm_r;
+}
+    
 } //namespace simcoon
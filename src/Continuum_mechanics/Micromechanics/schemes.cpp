@@ -26,6 +26,7 @@
 #include <assert.h>
 #include <armadillo>
 #include <memory>
+#include <simcoon/parameter.hpp>
 #include <simcoon/Simulation/Maths/rotation.hpp>
 #include <simcoon/Simulation/Phase/phase_characteristics.hpp>
 #include <simcoon/Simulation/Phase/state_variables.hpp>
@@ -44,11 +45,13 @@ using namespace std;
 using namespace arma;
 
 namespace simcoon{
+
+//Note The schemes iterate over the sub-phases by reference
   
 void Lt_Homogeneous_E(phase_characteristics &phase) {
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         r.sptr_multi->A = eye(6,6);
     }
 }
@@ -59,7 +62,8 @@ void DE_Homogeneous_E(phase_characteristics &phase) {
     std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
+        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
         r.sptr_multi->A = eye(6,6);
         sv_r->DEtot = r.sptr_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
     }
@@ -78,17 +82,17 @@ void Lt_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     std::shared_ptr<state_variables_M> sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
+        elli = r.sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
+        //Note T is only recomputed if the tangent moduli changed since its last computation
         if (r.sptr_matprops->number == n_matrix)
             elli_multi->T = eye(6,6);
         else
-            elli_multi->fillT(sv_0->Lt, sv_r->Lt, *elli);
+            elli_multi->updateT(sv_0->Lt, sv_r->Lt, *elli);
 
         //Compute the normalization interaction tensir sumT
 		sumT += elli->concentration*elli_multi->T;
@@ -97,12 +101,59 @@ void Lt_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
         elli_multi->A = elli_multi->T*inv_sumT;
     }
 }
 
+void TFA_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix, const std::vector<mat> &L) {
+    
+    //In each phase r, eps_r = A_r*E + sum_s D_in[s]*mu_s where mu_s is the inelastic strain of the phase s.
+    //With K_r = T_r*P_r the strain of the inclusion r per unit polarization (K = 0 for the matrix) and sumK = sum_s c_s*K_s:
+    //D_in[s] = K_r*L_s*delta_rs - c_s*A_r*K_s*L_s for s != n_matrix, and D_in[n_matrix] = (A_r*sumK - K_r)*L_m
+    unsigned int nphases = phase.sub_phases.size();
+    mat sumT = zeros(6,6);
+    mat sumK = zeros(6,6);
+    mat inv_sumT = zeros(6,6);
+    std::vector<mat> K(nphases, mat(6,6,fill::zeros));
+    
+    std::shared_ptr<ellipsoid_multi> elli_multi;
+    std::shared_ptr<ellipsoid> elli;
+    
+    for (unsigned int i=0; i<nphases; i++) {
+        elli_multi = phase.sub_phases[i].sptr_ellipsoid_multi;
+        elli = phase.sub_phases[i].sptr_ellipsoid;
+        
+        if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
+            elli_multi->T = eye(6,6);
+        else {
+            elli_multi->fillT(L[n_matrix], L[i], *elli);
+            mat L_m_local_geom = rotate_g2l_L(L[n_matrix], elli->psi_geom, elli->theta_geom, elli->phi_geom);
+            K[i] = rotate_l2g_M(elli_multi->T_loc*elli_multi->S_loc*inv(L_m_local_geom), elli->psi_geom, elli->theta_geom, elli->phi_geom);
+        }
+        
+        sumT += elli->concentration*elli_multi->T;
+        sumK += elli->concentration*K[i];
+    }
+    
+    inv_sumT = inv(sumT);
+    
+    for (unsigned int i=0; i<nphases; i++) {
+        elli_multi = phase.sub_phases[i].sptr_ellipsoid_multi;
+        elli_multi->A = elli_multi->T*inv_sumT;
+        elli_multi->D_in.resize(nphases);
+        
+        for (unsigned int j=0; j<nphases; j++) {
+            if (phase.sub_phases[j].sptr_matprops->number == n_matrix)
+                elli_multi->D_in[j] = (elli_multi->A*sumK - K[i])*L[j];
+            else
+                elli_multi->D_in[j] = -1.*phase.sub_phases[j].sptr_shape->concentration*elli_multi->A*K[j]*L[j];
+        }
+        elli_multi->D_in[i] += K[i]*L[i];
+    }
+}
+
 void Lt_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     
     mat sumT = zeros(6,6);
@@ -116,17 +167,17 @@ void Lt_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     std::shared_ptr<state_variables_M> sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
+        elli = r.sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
+        //Note T is only recomputed if the tangent moduli changed since its last computation
         if (r.sptr_matprops->number == n_matrix)
             elli_multi->T = eye(6,6);
         else
-            elli_multi->fillT_iso(sv_0->Lt, sv_r->Lt, *elli);
+            elli_multi->updateT_iso(sv_0->Lt, sv_r->Lt, *elli);
         
         //Compute the normalization interaction tensir sumT
         sumT += elli->concentration*elli_multi->T;
@@ -135,8 +186,8 @@ void Lt_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
         elli_multi->A = elli_multi->T*inv_sumT;
     }
 }
@@ -154,16 +205,16 @@ void DE_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     std::shared_ptr<state_variables_M> sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
+        elli = r.sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (r.sptr_matprops->number == n_matrix)
             elli_multi->T = eye(6,6);
         else
-            elli_multi->fillT(sv_0->Lt, sv_r->Lt, *elli);
+            elli_multi->updateT(sv_0->Lt, sv_r->Lt, *elli);
 
         //Compute the normalization interaction tensir sumT
         sumT += elli->concentration*elli_multi->T;
@@ -172,8 +223,8 @@ void DE_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
         
         elli_multi->A = elli_multi->T*inv_sumT;
@@ -194,16 +245,16 @@ void DE_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     std::shared_ptr<state_variables_M> sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
+        elli = r.sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (r.sptr_matprops->number == n_matrix)
             elli_multi->T = eye(6,6);
         else
-            elli_multi->fillT_iso(sv_0->Lt, sv_r->Lt, *elli);
+            elli_multi->updateT_iso(sv_0->Lt, sv_r->Lt, *elli);
         
         //Compute the normalization interaction tensir sumT
         sumT += elli->concentration*elli_multi->T;
@@ -212,8 +263,8 @@ void DE_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.sptr_ellipsoid_multi;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
         
         elli_multi->A = elli_multi->T*inv_sumT;
@@ -243,8 +294,8 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
         //Compute the effective tensor from the previous strain localization tensors
         mat Lt_eff = zeros(6,6);
         for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-            elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-            elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
+            elli_multi = phase.sub_phases[i].sptr_ellipsoid_multi;
+            elli = phase.sub_phases[i].sptr_ellipsoid;
             sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
             Lt_eff += elli->concentration*elli_multi->A*sv_r->Lt;
         }
@@ -254,15 +305,15 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     mat sumA = zeros(6,6);
     //Compute the Eshelby tensor and the interaction tensor for each phase
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
+        elli_multi = phase.sub_phases[i].sptr_ellipsoid_multi;
+        elli = phase.sub_phases[i].sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
             elli_multi->T = eye(6,6);
         else {
-            elli_multi->fillT(sv_eff->Lt, sv_r->Lt, *elli);
+            elli_multi->updateT(sv_eff->Lt, sv_r->Lt, *elli);
             sumA += elli->concentration*elli_multi->T;
         }
 
@@ -270,8 +321,8 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
+        elli_multi = phase.sub_phases[i].sptr_ellipsoid_multi;
+        elli = phase.sub_phases[i].sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
             elli_multi->A = (eye(6,6) - sumA)*(1./elli->concentration);
@@ -302,7 +353,7 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
         
         //Compute the effective tensor from the previous strain localization tensors
         mat Lt_eff = zeros(6,6);
-        for(auto r : phase.sub_phases) {
+        for(auto &r : phase.sub_phases) {
             sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
             Lt_eff += r.sptr_shape->concentration*r.sptr_multi->A*sv_r->Lt;
         }
@@ -312,15 +363,15 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     mat sumA = zeros(6,6);
     //Compute the Eshelby tensor and the interaction tensor for each phase
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
+        elli_multi = phase.sub_phases[i].sptr_ellipsoid_multi;
+        elli = phase.sub_phases[i].sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
             elli_multi->T = eye(6,6);
         else {
-            elli_multi->fillT(sv_eff->Lt, sv_r->Lt, *elli);
+            elli_multi->updateT(sv_eff->Lt, sv_r->Lt, *elli);
             sumA += elli->concentration*elli_multi->T;
         }
         
@@ -328,8 +379,8 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
 
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
+        elli_multi = phase.sub_phases[i].sptr_ellipsoid_multi;
+        elli = phase.sub_phases[i].sptr_ellipsoid;
         sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
             elli_multi->A = (eye(6,6) - sumA)*(1./elli->concentration);
@@ -341,6 +392,86 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     }
 }
     
+//21 independent components of a (symmetrized) tangent modulus
+static vec sym_to_21(const mat &L)
+{
+    vec x = zeros(21);
+    int z = 0;
+    for (int i=0; i<6; i++) {
+        for (int j=i; j<6; j++) {
+            x(z) = 0.5*(L(i,j) + L(j,i));
+            z++;
+        }
+    }
+    return x;
+}
+
+static mat sym_from_21(const vec &x)
+{
+    mat L = zeros(6,6);
+    int z = 0;
+    for (int i=0; i<6; i++) {
+        for (int j=i; j<6; j++) {
+            L(i,j) = x(z);
+            L(j,i) = x(z);
+            z++;
+        }
+    }
+    return L;
+}
+
+int Lt_Self_Consistent_Broyden(phase_characteristics &phase, const int &n_matrix, const bool &start, const int &option_start, const bool &warm_start) {
+    
+    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    
+    //Initial guess: the current effective tangent modulus (warm start), or the estimate of the start option (0 : h_E, 1 : MT)
+    if ((start)||(!warm_start))
+        Lt_Self_Consistent(phase, n_matrix, true, option_start);
+    
+    //Residual of the self-consistent equations: Lt_eff(L_ref) - L_ref. Each evaluation is a sweep over the phases (Eshelby tensors)
+    auto residual = [&](const vec &x) {
+        sv_eff->Lt = sym_from_21(x);
+        Lt_Self_Consistent(phase, n_matrix, false, option_start);
+        
+        mat Lt_eff = zeros(6,6);
+        for(auto &r : phase.sub_phases) {
+            std::shared_ptr<state_variables_M> sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+            Lt_eff += r.sptr_shape->concentration*sv_r->Lt*r.sptr_multi->A;
+        }
+        return vec(sym_to_21(Lt_eff) - x);
+    };
+    
+    vec x = sym_to_21(sv_eff->Lt);
+    vec F = residual(x);
+    int nbiter = 1;
+    
+    //Inverse of the Jacobian, initialized so that the first step is the fixed-point one
+    mat H = -1.*eye(21,21);
+    vec s = zeros(21);
+    vec y = zeros(21);
+    vec Hy = zeros(21);
+    
+    while ((norm(F,2) > precision_micro*norm(x,2))&&(nbiter <= maxiter_micro)) {
+        s = -1.*H*F;
+        x += s;
+        vec F_new = residual(x);
+        nbiter++;
+        
+        //"Good" Broyden update of the inverse Jacobian (Sherman-Morrison)
+        y = F_new - F;
+        Hy = H*y;
+        double denom = dot(s, Hy);
+        if (fabs(denom) > sim_iota*norm(s,2)*norm(Hy,2))
+            H += (s - Hy)*(s.t()*H)/denom;
+        else
+            H = -1.*eye(21,21);
+        F = F_new;
+    }
+    
+    //The concentration tensors correspond to the last reference medium
+    return nbiter;
+}
+    
 void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
     
     std::shared_ptr<layer_multi> lay_multi;
@@ -349,62 +480,38 @@ void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
     std::shared_ptr<state_variables_M> sv_r;
     std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
     
-    mat Lt_loc = zeros(6,6);
-    
     if (nbiter == 0) {
-        for (auto r : phase.sub_phases) {
+        for (auto &r : phase.sub_phases) {
             r.sptr_sv_global->DEtot = sv_eff->DEtot;
         }
     }
     
-    //Compute the increment of strain
+    //Compute the increment of strain: the normal parts of the stiffness and of the stress of the layers are accumulated in a single pass
     mat sumDnn = zeros(3,3);
 	vec sumcDsig = zeros(3);
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        lay_multi = r.sptr_layer_multi;
+        lay = r.sptr_layer;
         
-        lay_multi->Dnn(0,0) = Lt_loc(0,0);
-        lay_multi->Dnn(0,1) = Lt_loc(0,3);
-        lay_multi->Dnn(0,2) = Lt_loc(0,4);
-        lay_multi->Dnn(1,0) = Lt_loc(3,0);
-        lay_multi->Dnn(1,1) = Lt_loc(3,3);
-        lay_multi->Dnn(1,2) = Lt_loc(3,4);
-        lay_multi->Dnn(2,0) = Lt_loc(4,0);
-        lay_multi->Dnn(2,1) = Lt_loc(4,3);
-        lay_multi->Dnn(2,2) = Lt_loc(4,4);
+        //Note Dnn and inv_Dnn are only recomputed for the layers whose tangent modulus changed
+        lay_multi->updateD(sv_r->Lt, *lay);
+        lay_multi->sigma_hat = lay_multi->QS_n*sv_r->sigma;
         
-        mat sigma_local = rotate_g2l_stress(sv_r->sigma, lay->psi_geom, lay->theta_geom, lay->phi_geom);
-        lay_multi->sigma_hat(0) = sigma_local(0);
-        lay_multi->sigma_hat(1) = sigma_local(3);
-        lay_multi->sigma_hat(2) = sigma_local(4);
+        sumDnn += lay->concentration*lay_multi->inv_Dnn;
+        sumcDsig += lay->concentration*(lay_multi->inv_Dnn*lay_multi->sigma_hat);
     }
+    vec m = solve(sumDnn, sumcDsig);
     
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        sumDnn += lay->concentration*inv(lay_multi->Dnn);
-        sumcDsig += lay->concentration*inv(lay_multi->Dnn)*lay_multi->sigma_hat;
-    }
-    vec m = inv(sumDnn)*sumcDsig;
-    
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay_multi->dzdx1 = inv(lay_multi->Dnn)*(m-lay_multi->sigma_hat);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
+        lay_multi = r.sptr_layer_multi;
+        lay_multi->dzdx1 = lay_multi->inv_Dnn*(m-lay_multi->sigma_hat);
         
-        mat dEtot_local = zeros(6);
-        dEtot_local(0) = lay_multi->dzdx1(0);
-        dEtot_local(3) = lay_multi->dzdx1(1);
-        dEtot_local(4) = lay_multi->dzdx1(2);
-        mat dEtot_global = rotate_l2g_strain(dEtot_local, lay->psi_geom, lay->theta_geom, lay->phi_geom);
-        
-        sv_r->DEtot += dEtot_global;
+        //The strain rotation from local to global is the transpose of the stress rotation from global to local
+        sv_r->DEtot += lay_multi->QS_n.t()*lay_multi->dzdx1;
     }
 }
     
@@ -415,79 +522,28 @@ void Lt_Periodic_Layer(phase_characteristics &phase) {
     //ptr on the matrix properties
     std::shared_ptr<state_variables_M> sv_r;
     
-    mat Lt_loc = zeros(6,6);
-    mat A_loc = zeros(6,6);
-    
-    //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    //Compute the strain concentration tensor A: the normal and tangent parts of the layers are accumulated in a single pass
+    mat sumDnn = zeros(3,3);
+    mat sumDnt = zeros(3,3);
+    for(auto &r : phase.sub_phases) {
         
         sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        lay_multi = r.sptr_layer_multi;
+        lay = r.sptr_layer;
         
-        lay_multi->Dnn(0,0) = Lt_loc(0,0);
-        lay_multi->Dnn(0,1) = Lt_loc(0,3);
-        lay_multi->Dnn(0,2) = Lt_loc(0,4);
-        lay_multi->Dnn(1,0) = Lt_loc(3,0);
-        lay_multi->Dnn(1,1) = Lt_loc(3,3);
-        lay_multi->Dnn(1,2) = Lt_loc(3,4);
-        lay_multi->Dnn(2,0) = Lt_loc(4,0);
-        lay_multi->Dnn(2,1) = Lt_loc(4,3);
-        lay_multi->Dnn(2,2) = Lt_loc(4,4);
+        //Note Dnn, Dnt and inv_Dnn are only recomputed for the layers whose tangent modulus changed
+        lay_multi->updateD(sv_r->Lt, *lay);
         
-        lay_multi->Dnt(0,0) = Lt_loc(0,1);
-        lay_multi->Dnt(0,1) = Lt_loc(0,2);
-        lay_multi->Dnt(0,2) = Lt_loc(0,5);
-        lay_multi->Dnt(1,0) = Lt_loc(3,1);
-        lay_multi->Dnt(1,1) = Lt_loc(3,2);
-        lay_multi->Dnt(1,2) = Lt_loc(3,5);
-        lay_multi->Dnt(2,0) = Lt_loc(4,1);
-        lay_multi->Dnt(2,1) = Lt_loc(4,2);
-        lay_multi->Dnt(2,2) = Lt_loc(4,5);
-    }
-    
-    mat sumDnn = zeros(3,3);
-    mat sumDnt = zeros(3,3);
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        sumDnn += lay->concentration*inv(lay_multi->Dnn);
-        sumDnt += lay->concentration*inv(lay_multi->Dnn)*lay_multi->Dnt;
+        sumDnn += lay->concentration*lay_multi->inv_Dnn;
+        sumDnt += lay->concentration*(lay_multi->inv_Dnn*lay_multi->Dnt);
     }
     mat m_n = inv(sumDnn);
     mat m_t = m_n*sumDnt;
 
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);        
-        lay_multi->dXn = inv(lay_multi->Dnn)*(m_n-lay_multi->Dnn);
-        lay_multi->dXt = inv(lay_multi->Dnn)*(m_t-lay_multi->Dnt);
-        
-        A_loc = eye(6,6);
-        
-        A_loc(0,0) += lay_multi->dXn(0,0);
-        A_loc(0,1) += lay_multi->dXt(0,0);
-        A_loc(0,2) += lay_multi->dXt(0,1);
-        A_loc(0,3) += lay_multi->dXn(0,1);
-        A_loc(0,4) += lay_multi->dXn(0,2);
-        A_loc(0,5) += lay_multi->dXt(0,2);
-        
-        A_loc(3,0) += lay_multi->dXn(1,0);
-        A_loc(3,1) += lay_multi->dXt(1,0);
-        A_loc(3,2) += lay_multi->dXt(1,1);
-        A_loc(3,3) += lay_multi->dXn(1,1);
-        A_loc(3,4) += lay_multi->dXn(1,2);
-        A_loc(3,5) += lay_multi->dXt(1,2);
-        
-        A_loc(4,0) += lay_multi->dXn(2,0);
-        A_loc(4,1) += lay_multi->dXt(2,0);
-        A_loc(4,2) += lay_multi->dXt(2,1);
-        A_loc(4,3) += lay_multi->dXn(2,1);
-        A_loc(4,4) += lay_multi->dXn(2,2);
-        A_loc(4,5) += lay_multi->dXt(2,2);
-
-        lay_multi->A = rotate_l2g_A(A_loc, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+    for(auto &r : phase.sub_phases) {
+        lay_multi = r.sptr_layer_multi;
+        lay = r.sptr_layer;
+        lay_multi->fillA(m_n, m_t, *lay);
     }
     
 }
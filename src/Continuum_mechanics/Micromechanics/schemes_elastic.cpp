@@ -0,0 +1,203 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+///@file schemes_elastic.cpp
+///@brief micromechanical schemes for linear elastic N-phases heterogeneous materials:
+///@brief the effective stiffness is computed directly from the stiffness, shape and volume fraction of the phases, without state variables nor input files
+///@version 1.0
+
+#include <iostream>
+#include <vector>
+#include <assert.h>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/rotation.hpp>
+#include <simcoon/Simulation/Maths/parallel.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
+#include <simcoon/Simulation/Geometry/layer.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/layer_multi.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_elastic.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+mat T_elastic(const mat &L_0, const mat &L, const ellipsoid &ell, const mat &xi, const vec &w, const bool &analytical) {
+    
+    //Same computation as ellipsoid_multi::fillT, with the integration directions given as arguments
+    mat L_0_local_geom = rotate_g2l_L(L_0, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat L_local_geom = rotate_g2l_L(L, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat S_loc;
+    if (analytical)
+        S_loc = Eshelby_select(L_0_local_geom, ell.a1, ell.a2, ell.a3, xi, w);
+    else
+        S_loc = Eshelby(L_0_local_geom, ell.a1, ell.a2, ell.a3, xi, w);
+    
+    mat T_loc = inv(eye(6,6) + S_loc*inv(L_0_local_geom)*(L_local_geom - L_0_local_geom));
+    return rotate_l2g_A(T_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+}
+    
+mat L_eff_Homogeneous_E(const vector<mat> &L, const vec &c) {
+    
+    assert(L.size() == c.n_elem);
+    mat L_eff = zeros(6,6);
+    for (unsigned int i=0; i<L.size(); i++) {
+        L_eff += c(i)*L[i];
+    }
+    return L_eff;
+}
+    
+mat L_eff_Mori_Tanaka(const vector<mat> &L, const vector<ellipsoid> &ell, const int &n_matrix, const mat &xi, const vec &w, const bool &analytical) {
+    
+    assert(L.size() == ell.size());
+    assert((n_matrix >= 0)&&(n_matrix < (int)L.size()));
+    unsigned int nphases = L.size();
+    
+    vector<mat> T(nphases);
+    mat sumT = zeros(6,6);
+    for (unsigned int i=0; i<nphases; i++) {
+        if ((int)i == n_matrix)
+            T[i] = eye(6,6);
+        else
+            T[i] = T_elastic(L[n_matrix], L[i], ell[i], xi, w, analytical);
+        sumT += ell[i].concentration*T[i];
+    }
+    
+    mat inv_sumT = inv(sumT);
+    mat L_eff = zeros(6,6);
+    for (unsigned int i=0; i<nphases; i++) {
+        L_eff += ell[i].concentration*L[i]*T[i]*inv_sumT;
+    }
+    return L_eff;
+}
+
+mat L_eff_Self_Consistent(const vector<mat> &L, const vector<ellipsoid> &ell, const int &n_matrix, const mat &xi, const vec &w, const bool &analytical) {
+    
+    assert(L.size() == ell.size());
+    unsigned int nphases = L.size();
+    
+    //Initial estimate
+    mat L_eff = zeros(6,6);
+    if (n_matrix < 0) {
+        vec c = zeros(nphases);
+        for (unsigned int i=0; i<nphases; i++) {
+            c(i) = ell[i].concentration;
+        }
+        L_eff = L_eff_Homogeneous_E(L, c);
+    }
+    else
+        L_eff = L_eff_Mori_Tanaka(L, ell, n_matrix, xi, w, analytical);
+    
+    //Fixed-point iteration on the reference medium. As in Lt_Self_Consistent, the concentration tensor of the matrix phase ensures that the strain average is exact
+    mat L_n = zeros(6,6);
+    vector<mat> A(nphases);
+    int nbiter = 0;
+    double error = 1.;
+    while ((error > precision_micro)&&(nbiter <= maxiter_micro)) {
+        
+        L_n = L_eff;
+        mat sumA = zeros(6,6);
+        for (unsigned int i=0; i<nphases; i++) {
+            if ((int)i != n_matrix) {
+                A[i] = T_elastic(L_n, L[i], ell[i], xi, w, analytical);
+                sumA += ell[i].concentration*A[i];
+            }
+        }
+        if (n_matrix >= 0)
+            A[n_matrix] = (eye(6,6) - sumA)*(1./ell[n_matrix].concentration);
+        
+        L_eff = zeros(6,6);
+        for (unsigned int i=0; i<nphases; i++) {
+            L_eff += ell[i].concentration*L[i]*A[i];
+        }
+        error = norm(L_eff - L_n,2)/norm(L_eff,2);
+        nbiter++;
+    }
+    return L_eff;
+}
+
+mat L_eff_Periodic_Layer(const vector<mat> &L, const vector<layer> &lay) {
+    
+    assert(L.size() == lay.size());
+    unsigned int nlayers = L.size();
+    
+    //The layer_multi objects are only utilized for the computation of the normal and tangent parts of the stiffness, and the concentration tensors
+    vector<layer_multi> lay_multi(nlayers);
+    mat sumDnn = zeros(3,3);
+    mat sumDnt = zeros(3,3);
+    for (unsigned int i=0; i<nlayers; i++) {
+        //The rotations are shared by the consecutive layers of same orientation
+        if ((i > 0)&&(lay[i].psi_geom == lay[i-1].psi_geom)&&(lay[i].theta_geom == lay[i-1].theta_geom)&&(lay[i].phi_geom == lay[i-1].phi_geom)) {
+            lay_multi[i].QS_n = lay_multi[i-1].QS_n;
+            lay_multi[i].QS_t = lay_multi[i-1].QS_t;
+            lay_multi[i].QE = lay_multi[i-1].QE;
+            lay_multi[i].angles_Q = lay_multi[i-1].angles_Q;
+        }
+        lay_multi[i].updateD(L[i], lay[i]);
+        sumDnn += lay[i].concentration*lay_multi[i].inv_Dnn;
+        sumDnt += lay[i].concentration*(lay_multi[i].inv_Dnn*lay_multi[i].Dnt);
+    }
+    mat m_n = inv(sumDnn);
+    mat m_t = m_n*sumDnt;
+    
+    mat L_eff = zeros(6,6);
+    for (unsigned int i=0; i<nlayers; i++) {
+        lay_multi[i].fillA(m_n, m_t, lay[i]);
+        L_eff += lay[i].concentration*L[i]*lay_multi[i].A;
+    }
+    return L_eff;
+}
+    
+vector<mat> L_eff_batch(const vector<vector<mat> > &L, const vector<vector<ellipsoid> > &ell, const int &method, const int &n_matrix, const mat &xi, const vec &w, const bool &analytical) {
+    
+    assert(L.size() == ell.size());
+    unsigned int nvariants = L.size();
+    vector<mat> L_eff(nvariants, mat(6,6,fill::zeros));
+    
+    if ((method != 100)&&(method != 101)&&(method != 103)) {
+        cout << "Error: the batch evaluation of the effective stiffness is available for the micromechanical schemes of ellipsoidal phases only (MIHEN, MIMTN, MISCN)\n";
+        return L_eff;
+    }
+    
+    //The variants share nothing but the (read-only) integration directions
+    parallel_for(nvariants, [&](const unsigned int &i) {
+        switch (method) {
+            case 100: {
+                vec c = zeros(ell[i].size());
+                for (unsigned int j=0; j<ell[i].size(); j++) {
+                    c(j) = ell[i][j].concentration;
+                }
+                L_eff[i] = L_eff_Homogeneous_E(L[i], c);
+                break;
+            }
+            case 101: {
+                L_eff[i] = L_eff_Mori_Tanaka(L[i], ell[i], n_matrix, xi, w, analytical);
+                break;
+            }
+            case 103: {
+                L_eff[i] = L_eff_Self_Consistent(L[i], ell[i], n_matrix, xi, w, analytical);
+                break;
+            }
+        }
+    });
+    return L_eff;
+}
+    
+} //namespace simcoon
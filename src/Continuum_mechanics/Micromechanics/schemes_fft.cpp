@@ -0,0 +1,342 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file schemes_fft.cpp
+///@brief FFT-based full-field homogenization of periodic voxel microstructures (Moulinec-Suquet scheme)
+///@version 1.0
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <armadillo>
+#include <memory>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/parallel.hpp>
+#include <simcoon/Simulation/Maths/num_solve.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+#include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/voxel_multi.hpp>
+#include <simcoon/Continuum_mechanics/Umat/umat_smart.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_fft.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+//The fields over the grid are (nvoxels x 6) matrices, one row per voxel in the order i + n1*(j + n2*k), in Voigt notation.
+//The discrete Fourier transforms are the ones of Armadillo (its bundled FFT, or FFTW3 if Armadillo is configured with it)
+
+//Voxels of each sub-phase (the rows index of the fields over the grid), with the size of the grid and the reference medium
+static void grid_voxels(phase_characteristics &phase, std::vector<std::shared_ptr<voxel_multi> > &vox, unsigned int &n1, unsigned int &n2, unsigned int &n3, double &lambda_0, double &mu_0) {
+    
+    vox.resize(phase.sub_phases.size());
+    for (unsigned int p=0; p<phase.sub_phases.size(); p++) {
+        vox[p] = std::dynamic_pointer_cast<voxel_multi>(phase.sub_phases[p].sptr_multi);
+    }
+    n1 = vox[0]->n1;
+    n2 = vox[0]->n2;
+    n3 = vox[0]->n3;
+    lambda_0 = vox[0]->lambda_0;
+    mu_0 = vox[0]->mu_0;
+}
+
+//Frequency of the index i of a discrete Fourier transform of size n
+static double frequency(const unsigned int &i, const unsigned int &n) {
+    return (i < (n+1)/2) ? double(i) : double(i) - double(n);
+}
+
+//Fixed point of the Moulinec-Suquet scheme eps <- eps - Gamma_0*sigma(eps), which keeps the average of the strain field.
+//It stops when the correction is lower than precision_fft*norm_ref, or after maxiter_fft iterations; in both cases sigma = sigma(eps)
+static int fft_fixed_point(mat &eps, mat &sigma, const std::function<void(const mat &, mat &)> &sigma_field, const unsigned int &n1, const unsigned int &n2, const unsigned int &n3, const double &lambda_0, const double &mu_0, const int &scheme, const double &norm_ref) {
+    
+    unsigned int nvoxels = eps.n_rows;
+    bool anderson = ((scheme == 1)&&(depth_anderson_fft > 0));
+    mat dG;
+    mat dF;
+    vec g_prev;
+    vec f_prev;
+    mat Deps = zeros(nvoxels, 6);
+    cx_mat tau_hat;
+    
+    int nbiter = 0;
+    double error = 1.;
+    double error_prev = 0.;
+    bool converged = false;
+    
+    while (nbiter <= maxiter_fft) {
+        
+        sigma_field(eps, sigma);
+        
+        tau_hat = cx_mat(sigma, zeros(nvoxels, 6));
+        fft_3D(tau_hat, n1, n2, n3);
+        Gamma_0_fft(tau_hat, n1, n2, n3, lambda_0, mu_0);
+        fft_3D(tau_hat, n1, n2, n3, true);
+        Deps = real(tau_hat);
+        
+        error = norm(Deps,"fro")/norm_ref;
+        if (error < precision_fft) {
+            converged = true;
+            break;
+        }
+        
+        //The Anderson history is restarted if the residual increases: the next iterate is a plain fixed-point one
+        if ((anderson)&&(nbiter > 0)&&((error > error_prev)||(!std::isfinite(error)))) {
+            dG.reset();
+            dF.reset();
+            g_prev.reset();
+            f_prev.reset();
+        }
+        error_prev = error;
+        
+        if (anderson) {
+            vec x_new = Anderson_mixing(vectorise(eps), vectorise(eps - Deps), dG, dF, g_prev, f_prev, depth_anderson_fft);
+            eps = reshape(x_new, nvoxels, 6);
+        }
+        else
+            eps -= Deps;
+        nbiter++;
+    }
+    
+    //Without convergence, the last correction has been applied to eps: the stress is updated accordingly
+    if (!converged)
+        sigma_field(eps, sigma);
+    return nbiter;
+}
+    
+void fft_3D(cx_mat &f, const unsigned int &n1, const unsigned int &n2, const unsigned int &n3, const bool &inverse) {
+    
+    //The transforms of size 1 are skipped: Armadillo would transform a (1 x n) matrix along its rows
+    for (unsigned int c=0; c<f.n_cols; c++) {
+        for (unsigned int k=0; k<n3; k++) {
+            cx_mat S(f.colptr(c) + n1*n2*k, n1, n2, false, true);
+            if (n1 > 1) {
+                if (inverse)
+                    S = ifft(S);
+                else
+                    S = fft(S);
+            }
+            if (n2 > 1) {
+                if (inverse)
+                    S = strans(ifft(strans(S)));
+                else
+                    S = strans(fft(strans(S)));
+            }
+        }
+        if (n3 > 1) {
+            cx_mat M(f.colptr(c), n1*n2, n3, false, true);
+            if (inverse)
+                M = strans(ifft(strans(M)));
+            else
+                M = strans(fft(strans(M)));
+        }
+    }
+}
+
+void Gamma_0_fft(cx_mat &tau_hat, const unsigned int &n1, const unsigned int &n2, const unsigned int &n3, const double &lambda_0, const double &mu_0) {
+    
+    //With q = xi/|xi|, and v = tau.q : eps_ij = (q_i*v_j + q_j*v_i)/(2*mu_0) - (lambda_0 + mu_0)/(mu_0*(lambda_0 + 2*mu_0))*q_i*q_j*(q.v)
+    //The frequencies are scaled by the size of the grid in each direction (cubic voxels). The average (xi = 0) is cancelled,
+    //as well as the Nyquist frequencies (i = n/2 for an even size n), whose transform is not the one of a real symmetric field
+    double c_0 = (lambda_0 + mu_0)/(mu_0*(lambda_0 + 2.*mu_0));
+    
+    auto Gamma_slice = [&](const unsigned int &k) {
+        vec q = zeros(3);
+        std::complex<double> t[3][3];
+        std::complex<double> v[3];
+        std::complex<double> qv;
+        std::complex<double> e[3][3];
+        
+        for (unsigned int j=0; j<n2; j++) {
+            for (unsigned int i=0; i<n1; i++) {
+                unsigned int idx = i + n1*(j + n2*k);
+                if (((n1%2 == 0)&&(2*i == n1))||((n2%2 == 0)&&(2*j == n2))||((n3%2 == 0)&&(2*k == n3))) {
+                    tau_hat.row(idx).zeros();
+                    continue;
+                }
+                q(0) = frequency(i, n1)/double(n1);
+                q(1) = frequency(j, n2)/double(n2);
+                q(2) = frequency(k, n3)/double(n3);
+                double norm_q = norm(q,2);
+                if (norm_q < sim_iota) {
+                    tau_hat.row(idx).zeros();
+                    continue;
+                }
+                q /= norm_q;
+                
+                t[0][0] = tau_hat(idx,0);
+                t[1][1] = tau_hat(idx,1);
+                t[2][2] = tau_hat(idx,2);
+                t[0][1] = t[1][0] = tau_hat(idx,3);
+                t[0][2] = t[2][0] = tau_hat(idx,4);
+                t[1][2] = t[2][1] = tau_hat(idx,5);
+                
+                for (int a=0; a<3; a++) {
+                    v[a] = t[a][0]*q(0) + t[a][1]*q(1) + t[a][2]*q(2);
+                }
+                qv = q(0)*v[0] + q(1)*v[1] + q(2)*v[2];
+                for (int a=0; a<3; a++) {
+                    for (int b=a; b<3; b++) {
+                        e[a][b] = (q(a)*v[b] + q(b)*v[a])/(2.*mu_0) - c_0*q(a)*q(b)*qv;
+                    }
+                }
+                
+                tau_hat(idx,0) = e[0][0];
+                tau_hat(idx,1) = e[1][1];
+                tau_hat(idx,2) = e[2][2];
+                tau_hat(idx,3) = 2.*e[0][1];
+                tau_hat(idx,4) = 2.*e[0][2];
+                tau_hat(idx,5) = 2.*e[1][2];
+            }
+        }
+    };
+    
+    if (n1*n2*n3 >= nvoxels_parallel_fft)
+        parallel_for(n3, Gamma_slice);
+    else {
+        for (unsigned int k=0; k<n3; k++) {
+            Gamma_slice(k);
+        }
+    }
+}
+
+void reference_medium_fft(double &lambda_0, double &mu_0, const std::vector<mat> &L) {
+    
+    vec lambda = zeros(L.size());
+    vec mu = zeros(L.size());
+    for (unsigned int i=0; i<L.size(); i++) {
+        mat L_iso = Isotropize(L[i]);
+        lambda(i) = L_iso(0,1);
+        mu(i) = L_iso(3,3);
+    }
+    lambda_0 = 0.5*(lambda.min() + lambda.max());
+    mu_0 = 0.5*(mu.min() + mu.max());
+}
+
+int DE_FFT(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, bool &start, const unsigned int &solver_type, double &tnew_dt, const int &scheme) {
+    
+    std::vector<std::shared_ptr<voxel_multi> > vox;
+    unsigned int n1 = 0;
+    unsigned int n2 = 0;
+    unsigned int n3 = 0;
+    double lambda_0 = 0.;
+    double mu_0 = 0.;
+    grid_voxels(phase, vox, n1, n2, n3, lambda_0, mu_0);
+    unsigned int nvoxels = n1*n2*n3;
+    
+    std::shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    
+    //The voxels are evaluated concurrently for large grids, except at the first increment (start) as in umat_multi.
+    //The voxels of each sub-phase are split in blocks, and each block evaluates the constitutive model of the sub-phase with its own material object
+    unsigned int nblocks = ((!start)&&(nvoxels >= nvoxels_parallel_fft)) ? default_thread_pool().size() : 1;
+    std::vector<unsigned int> block_phase;
+    std::vector<unsigned int> block_first;
+    std::vector<unsigned int> block_last;
+    std::vector<phase_characteristics> materials;
+    for (unsigned int p=0; p<vox.size(); p++) {
+        phase_characteristics &r = phase.sub_phases[p];
+        unsigned int nvoxels_p = vox[p]->size();
+        unsigned int nblocks_p = std::min(nblocks, nvoxels_p);
+        for (unsigned int b=0; b<nblocks_p; b++) {
+            block_phase.push_back(p);
+            block_first.push_back((b*nvoxels_p)/nblocks_p);
+            block_last.push_back(((b+1)*nvoxels_p)/nblocks_p);
+            materials.push_back(phase_characteristics(0, 1, r.sptr_shape, std::make_shared<phase_multi>(), r.sptr_matprops, std::make_shared<state_variables_M>(*std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global)), std::make_shared<state_variables_M>(*std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_local)), nullptr, nullptr, ""));
+        }
+    }
+    
+    auto evaluate_block = [&](const unsigned int &b, double &tnew_dt_b) {
+        std::shared_ptr<voxel_multi> &v = vox[block_phase[b]];
+        std::shared_ptr<state_variables_M> sv = std::dynamic_pointer_cast<state_variables_M>(materials[b].sptr_sv_global);
+        for (unsigned int i=block_first[b]; i<block_last[b]; i++) {
+            v->get(i, *sv);
+            select_umat_M(materials[b], DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt_b);
+            v->set(i, *sv);
+        }
+    };
+    
+    //The first iterate is the strain increment field of the last call, shifted to the current average: it is compatible
+    mat DE = zeros(nvoxels, 6);
+    for (auto &v : vox) {
+        DE.rows(v->index) = v->DEtot.t();
+    }
+    rowvec DE_shift = umat_phase_M->DEtot.t() - mean(DE,0);
+    DE.each_row() += DE_shift;
+    
+    auto sigma_field = [&](const mat &eps, mat &sigma) {
+        for (auto &v : vox) {
+            v->DEtot = eps.rows(v->index).t();
+        }
+        if (nblocks > 1) {
+            vec tnew_dt_b = tnew_dt*ones(materials.size());
+            parallel_for(materials.size(), [&](const unsigned int &b) {
+                evaluate_block(b, tnew_dt_b(b));
+            });
+            tnew_dt = tnew_dt_b.min();
+        }
+        else {
+            for (unsigned int b=0; b<materials.size(); b++) {
+                evaluate_block(b, tnew_dt);
+            }
+        }
+        for (auto &v : vox) {
+            sigma.rows(v->index) = v->sigma.t();
+        }
+    };
+    
+    mat sigma = zeros(nvoxels, 6);
+    double norm_ref = sqrt(double(nvoxels))*std::max(norm(umat_phase_M->Etot + umat_phase_M->DEtot,2), sim_iota);
+    return fft_fixed_point(DE, sigma, sigma_field, n1, n2, n3, lambda_0, mu_0, scheme, norm_ref);
+}
+
+mat Lt_FFT(phase_characteristics &phase, const int &scheme) {
+    
+    std::vector<std::shared_ptr<voxel_multi> > vox;
+    unsigned int n1 = 0;
+    unsigned int n2 = 0;
+    unsigned int n3 = 0;
+    double lambda_0 = 0.;
+    double mu_0 = 0.;
+    grid_voxels(phase, vox, n1, n2, n3, lambda_0, mu_0);
+    unsigned int nvoxels = n1*n2*n3;
+    
+    //The tangent modulus of each voxel is read in place from the fields of its sub-phase
+    auto sigma_field = [&](const mat &eps, mat &sigma) {
+        for (auto &v : vox) {
+            for (unsigned int i=0; i<v->size(); i++) {
+                const mat Lt_i(v->Lt.colptr(i), 6, 6, false, true);
+                sigma.row(v->index(i)) = eps.row(v->index(i))*Lt_i.t();
+            }
+        }
+    };
+    
+    mat Lt_eff = zeros(6,6);
+    mat eps = zeros(nvoxels, 6);
+    mat sigma = zeros(nvoxels, 6);
+    for (int j=0; j<6; j++) {
+        eps.zeros();
+        eps.col(j).ones();
+        fft_fixed_point(eps, sigma, sigma_field, n1, n2, n3, lambda_0, mu_0, scheme, sqrt(double(nvoxels)));
+        Lt_eff.col(j) = mean(sigma,0).t();
+    }
+    return Lt_eff;
+}
+    
+} //namespace simcoon
@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
 #include <assert.h>
 #include <string.h>
 #include <math.h>
@@ -32,7 +33,10 @@
 #include <simcoon/Simulation/Phase/read.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/ellipsoid_multi.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/voxel_multi.hpp>
 #include <simcoon/Continuum_mechanics/Micromechanics/schemes.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_fft.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/L_eff_table.hpp>
 
 using namespace std;
 using namespace arma;
@@ -45,23 +49,18 @@ void get_L_elastic(phase_characteristics &rve)
     string path_data = "data";
     string inputfile; //file # that stores the microstructure properties
     
-    std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104}};
+    //The list is built once, and not at each (recursive) call
+    static const std::map<string, int> list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104},{"MITFA",105},{"MIFFT",106},{"MITAB",107}};
     
-    int method = list_umat[rve.sptr_matprops->umat_name];
+    auto it_umat = list_umat.find(rve.sptr_matprops->umat_name);
+    int method = (it_umat != list_umat.end()) ? it_umat->second : 0;
     
     //first we read the behavior of the phases & we construct the tensors if necessary
     switch (method) {
             
-        case 100: case 101: case 103: {
+        case 100: case 101: case 103: case 105: {
             //Definition of the static vectors x,wx,y,wy
-            ellipsoid_multi::mp = rve.sptr_matprops->props(2);
-            ellipsoid_multi::np = rve.sptr_matprops->props(3);
-            ellipsoid_multi::x.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::wx.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::y.set_size(ellipsoid_multi::np);
-            ellipsoid_multi::wy.set_size(ellipsoid_multi::np);
-            points(ellipsoid_multi::x, ellipsoid_multi::wx, ellipsoid_multi::y, ellipsoid_multi::wy,ellipsoid_multi::mp, ellipsoid_multi::np);
+            ellipsoid_multi::set_quadrature(rve.sptr_matprops->props(2), rve.sptr_matprops->props(3));
             
             inputfile = "Nellipsoids" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
             read_ellipsoid(rve, path_data, inputfile);
@@ -72,6 +71,13 @@ void get_L_elastic(phase_characteristics &rve)
             read_layer(rve, path_data, inputfile);
             break;
         }
+        case 106: {
+            inputfile = "Nphases" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
+            read_phase(rve, path_data, inputfile);
+            inputfile = "Nvoxels" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
+            read_voxels(rve, path_data, inputfile);
+            break;
+        }
     }
     
     rve.global2local();
@@ -119,7 +125,7 @@ void get_L_elastic(phase_characteristics &rve)
             Lt_Homogeneous_E(rve);
             break;
         }
-        case 101: {
+        case 101: case 105: {
             for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
                 get_L_elastic(rve.sub_phases[i]);
             }
@@ -132,6 +138,10 @@ void get_L_elastic(phase_characteristics &rve)
                 get_L_elastic(rve.sub_phases[i]);
             }
             int n_matrix = rve.sptr_matprops->props(4);
+            if (broyden_SC_micro) {
+                Lt_Self_Consistent_Broyden(rve, n_matrix, true, 1);
+                break;
+            }
             Lt_Self_Consistent(rve, n_matrix, true, 1);
             
             mat Lt_n = zeros(6,6);
@@ -145,7 +155,7 @@ void get_L_elastic(phase_characteristics &rve)
                 }
                 Lt_Self_Consistent(rve, n_matrix, false, 1);
                 umat_M->Lt = zeros(6,6);
-                for (auto r : rve.sub_phases) {
+                for (auto &r : rve.sub_phases) {
                     umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
                     umat_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
                 }
@@ -161,6 +171,39 @@ void get_L_elastic(phase_characteristics &rve)
             Lt_Periodic_Layer(rve);
             break;
         }
+        case 106: {
+            //The voxels take the stiffness of their phase, and the effective stiffness solves the six full-field problems
+            std::vector<mat> L;
+            for (auto &r : rve.sub_phases) {
+                get_L_elastic(r);
+                umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+                L.push_back(umat_sub_phases_M->Lt);
+                
+                std::shared_ptr<voxel_multi> vox = std::dynamic_pointer_cast<voxel_multi>(r.sptr_multi);
+                vox->Lt = repmat(vectorise(umat_sub_phases_M->Lt), 1, vox->size());
+            }
+            
+            double lambda_0 = 0.;
+            double mu_0 = 0.;
+            reference_medium_fft(lambda_0, mu_0, L);
+            for (auto &r : rve.sub_phases) {
+                std::shared_ptr<voxel_multi> vox = std::dynamic_pointer_cast<voxel_multi>(r.sptr_multi);
+                vox->lambda_0 = lambda_0;
+                vox->mu_0 = mu_0;
+            }
+            umat_M->Lt = Lt_FFT(rve, 1);
+            break;
+        }
+        case 107: {
+            inputfile = path_data + "/L_eff_table" + to_string(int(rve.sptr_matprops->props(0))) + ".bin";
+            std::shared_ptr<const L_eff_table> lt = L_eff_table::shared(inputfile);
+            if (!lt) {
+                cout << "Error: The table of effective stiffness " << inputfile << " could not be read\n";
+                return;
+            }
+            umat_M->Lt = lt->interpolate(rve.sptr_matprops->props.tail(rve.sptr_matprops->props.n_elem - 1));
+            break;
+        }
         default: {
             cout << "Error: The choice of Cnstitutive model is not purely linear elastic or could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
             return;
@@ -169,11 +212,11 @@ void get_L_elastic(phase_characteristics &rve)
     
     switch (method) {
             
-	    case 100: case 101: case 103: case 104: {
+	    case 100: case 101: case 103: case 104: case 105: {
 
             // Compute the effective tangent modulus, and the effective stress
             umat_M->Lt = zeros(6,6);
-            for (auto r : rve.sub_phases) {
+            for (auto &r : rve.sub_phases) {
                 umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
                 umat_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
             }
@@ -116,15 +116,15 @@ namespace simcoon{
 
 void size_statev(phase_characteristics &rve, unsigned int &size) {
 
-    for (auto r:rve.sub_phases) {
-        size = size + r.sptr_sv_local->nstatev + 57;
+    for (auto &r:rve.sub_phases) {
+        size = size + r.sptr_sv_local->nstatev + 99;
         size_statev(r,size);
     }
 }
 
 void statev_2_phases(phase_characteristics &rve, unsigned int &pos, const vec &statev) {
 
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         //The number of statev is here determined for each phase, then a sub_vector of the statev vector is taken from this
         //vec Etot -> 6X
         //vec DEtot -> 6X 12
@@ -141,9 +141,11 @@ void statev_2_phases(phase_characteristics &rve, unsigned int &pos, const vec &s
         //vec Wm_start  -> 3X 26
         //mat L -> 36X 62
         //mat Lt -> 36
+        //mat A -> 36X 93 (strain concentration tensor of the last localization, for the warm start)
+        //vec DE_corr -> 6X 99
         
         //int nstatev
-        //vec statev    nstatevX 62+nstatev
+        //vec statev    nstatevX 99+nstatev
         //vec statev_start
 
         shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
@@ -160,8 +162,14 @@ void statev_2_phases(phase_characteristics &rve, unsigned int &pos, const vec &s
             umat_phase_M->Lt.col(i) = statev.subvec(pos+21+i*6,size(vide));
         }
         
-        umat_phase_M->statev = statev.subvec(pos+57,size(umat_phase_M->statev));
-        pos+=57+nstatev;
+        for (int i=0; i<6; i++) {
+            r.sptr_multi->A.col(i) = statev.subvec(pos+57+i*6,size(vide));
+        }
+        r.sptr_multi->A_start = r.sptr_multi->A;
+        r.sptr_multi->DE_corr = statev.subvec(pos+93,size(vide));
+        
+        umat_phase_M->statev = statev.subvec(pos+99,size(umat_phase_M->statev));
+        pos+=99+nstatev;
         statev_2_phases(r,pos,statev);
     }
 
@@ -169,7 +177,7 @@ void statev_2_phases(phase_characteristics &rve, unsigned int &pos, const vec &s
     
 void phases_2_statev(vec &statev, unsigned int &pos, const phase_characteristics &rve) {
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         //The number of statev is here determined for each phase, then a sub_vector of the statev vector is taken from this
         //vec Etot -> 6X
         //vec DEtot -> 6X 12
@@ -186,9 +194,11 @@ void phases_2_statev(vec &statev, unsigned int &pos, const phase_characteristics
         //vec Wm_start  -> 3X 26
         //mat L -> 36X 62
         //mat Lt -> 36
+        //mat A -> 36X 93 (strain concentration tensor of the last localization, for the warm start)
+        //vec DE_corr -> 6X 99
         
         //int nstatev
-        //vec statev    nstatevX 62+nstatev
+        //vec statev    nstatevX 99+nstatev
         //vec statev_start
         
         shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
@@ -203,9 +213,13 @@ void phases_2_statev(vec &statev, unsigned int &pos, const phase_characteristics
         for (int i=0; i<6; i++) {
             statev.subvec(pos+21+i*6,size(vide)) = umat_phase_M->Lt.col(i);
         }
-        statev.subvec(pos+57,size(umat_phase_M->statev)) = umat_phase_M->statev;
+        for (int i=0; i<6; i++) {
+            statev.subvec(pos+57+i*6,size(vide)) = r.sptr_multi->A.col(i);
+        }
+        statev.subvec(pos+93,size(vide)) = r.sptr_multi->DE_corr;
+        statev.subvec(pos+99,size(umat_phase_M->statev)) = umat_phase_M->statev;
         
-        pos+=57+nstatev;
+        pos+=99+nstatev;
         phases_2_statev(statev,pos,r);
     }
     
@@ -956,7 +970,7 @@ void select_umat_M(phase_characteristics &rve, const mat &DR,const double &Time,
 
     std::map<string, int> list_umat;
     
-    list_umat = {{"UMEXT",0},{"UMABA",1},{"ELISO",2},{"ELIST",3},{"ELORT",4},{"EPICP",5},{"EPKCP",6},{"EPCHA",7},{"SMAUT",8},{"LLDM0",9},{"ZENER",10},{"ZENNK",11},{"PRONK",12},{"EPHIC",17},{"EPHIN",18},{"SMAMO",19},{"SMAMC",20},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104}};
+    list_umat = {{"UMEXT",0},{"UMABA",1},{"ELISO",2},{"ELIST",3},{"ELORT",4},{"EPICP",5},{"EPKCP",6},{"EPCHA",7},{"SMAUT",8},{"LLDM0",9},{"ZENER",10},{"ZENNK",11},{"PRONK",12},{"EPHIC",17},{"EPHIN",18},{"SMAMO",19},{"SMAMC",20},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104},{"MITFA",105},{"MIFFT",106},{"MITAB",107}};
     
         rve.global2local();
         auto umat_M = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_local);
@@ -1051,6 +1065,18 @@ void select_umat_M(phase_characteristics &rve, const mat &DR,const double &Time,
                 umat_multi(rve, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt, list_umat[rve.sptr_matprops->umat_name]);
                 break;
             }
+            case 105: {
+                umat_multi_TFA(rve, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+                break;
+            }
+            case 106: {
+                umat_multi_FFT(rve, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+                break;
+            }
+            case 107: {
+                umat_multi_table(rve, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+                break;
+            }
             default: {
                 cout << "Error: The choice of Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
                 exit(0);
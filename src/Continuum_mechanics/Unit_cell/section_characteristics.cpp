@@ -183,7 +183,7 @@ ostream& operator << (ostream& s, const section_characteristics& sc)
 	s << "Display material characteristics:\n";
     s << sc.abamat;
     
-    for(auto r : sc.sub_sections) {
+    for(auto &r : sc.sub_sections) {
         s << r;
     }
     
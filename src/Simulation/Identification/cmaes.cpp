@@ -0,0 +1,269 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file cmaes.cpp
+///@brief Covariance matrix adaptation evolution strategy (CMA-ES) with restarts, to generate the individuals of the identification
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/random.hpp>
+#include <simcoon/Simulation/Identification/parameters.hpp>
+#include <simcoon/Simulation/Identification/generation.hpp>
+#include <simcoon/Simulation/Identification/cmaes.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+//=====Private methods for cmaes===================================
+
+//=====Public methods for cmaes============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+cmaes::cmaes()
+//-------------------------------------------------------------
+{
+    n = 0;
+    lambda = 0;
+    mu = 0;
+    mueff = 0.;
+    cc = 0.;
+    cs = 0.;
+    c1 = 0.;
+    cmu = 0.;
+    damps = 0.;
+    chiN = 0.;
+    sigma = 0.;
+    sigma0 = 0.;
+    ngen = 0;
+    restarts = 0;
+    best_cost = datum::inf;
+    stagnation = 0;
+}
+
+/*!
+ \brief Constructor
+ \param params : parameters identified (the bounds normalize the parameters)
+ \param mlambda : number of individuals sampled at each generation
+ \param p0 : initial mean (parameters values)
+ \param msigma0 : initial step size, relative to the ranges of the parameters
+ The strategy parameters are the default ones of Hansen, The CMA Evolution Strategy: A Tutorial (2016)
+ */
+
+//-------------------------------------------------------------
+cmaes::cmaes(const vector<parameters> &params, const int &mlambda, const vec &p0, const double &msigma0)
+//-------------------------------------------------------------
+{
+    n = params.size();
+    lambda = mlambda;
+    mu = std::max(lambda/2, 1);
+    assert(n > 0);
+    assert(lambda > 1);
+    
+    weights = zeros(mu);
+    for(int i=0; i<mu; i++) {
+        weights(i) = log(mu + 0.5) - log(i + 1.);
+    }
+    weights /= accu(weights);
+    mueff = 1./accu(square(weights));
+    
+    double N = double(n);
+    cc = (4. + mueff/N)/(N + 4. + 2.*mueff/N);
+    cs = (mueff + 2.)/(N + mueff + 5.);
+    c1 = 2./((N + 1.3)*(N + 1.3) + mueff);
+    cmu = std::min(1. - c1, 2.*(mueff - 2. + 1./mueff)/((N + 2.)*(N + 2.) + mueff));
+    damps = 1. + 2.*std::max(0., sqrt((mueff - 1.)/(N + 1.)) - 1.) + cs;
+    chiN = sqrt(N)*(1. - 1./(4.*N) + 1./(21.*N*N));
+    
+    min_values = zeros(n);
+    ranges = ones(n);
+    for(int j=0; j<n; j++) {
+        min_values(j) = params[j].min_value;
+        if (params[j].max_value - params[j].min_value > 0.)
+            ranges(j) = params[j].max_value - params[j].min_value;
+    }
+    
+    sigma0 = msigma0;
+    restarts = 0;
+    restart((p0 - min_values)/ranges);
+    restarts = 0;
+}
+
+/*!
+ \brief Copy constructor
+ \param es cmaes object to duplicate
+ */
+
+//------------------------------------------------------
+cmaes::cmaes(const cmaes& es)
+//------------------------------------------------------
+{
+    *this = es;
+}
+
+/*!
+ \brief destructor
+ */
+
+cmaes::~cmaes() {}
+
+//-------------------------------------------------------------
+void cmaes::sample(generation &gensons, int &idnumber) const
+//-------------------------------------------------------------
+{
+    gensons.newid(idnumber);
+    for(int i=0; i<gensons.size(); i++) {
+        vec z = randn<vec>(n);
+        vec y = m + sigma*(B*(D % z));
+        //Sampled points out of the bounds are projected on them
+        y = clamp(y, 0., 1.);
+        gensons.pop[i].p = min_values + ranges % y;
+    }
+}
+
+//-------------------------------------------------------------
+void cmaes::update(const generation &gensons)
+//-------------------------------------------------------------
+{
+    int npop = gensons.size();
+    int nsel = std::min(mu, npop);
+    
+    //Ranking of the individuals, the failed evaluations (NaN) being the worst ones
+    vec costs = zeros(npop);
+    mat Y = zeros(n, npop);
+    for(int i=0; i<npop; i++) {
+        costs(i) = (std::isnan(gensons.pop[i].cout)) ? datum::inf : gensons.pop[i].cout;
+        Y.col(i) = (gensons.pop[i].p - min_values)/ranges;
+    }
+    uvec idx = sort_index(costs);
+    
+    if ((std::isinf(best_cost))||(costs(idx(0)) < best_cost - sim_iota*fabs(best_cost))) {
+        best_cost = costs(idx(0));
+        stagnation = 0;
+    }
+    else
+        stagnation++;
+    
+    vec w = weights.head(nsel)/accu(weights.head(nsel));
+    mat Ysel = Y.cols(idx.head(nsel));
+    vec m_old = m;
+    m = Ysel*w;
+    ngen++;
+    
+    mat invsqrtC = B*diagmat(1./D)*B.t();
+    vec dm = (m - m_old)/sigma;
+    ps = (1. - cs)*ps + sqrt(cs*(2. - cs)*mueff)*(invsqrtC*dm);
+    double hsig = (norm(ps)/sqrt(1. - pow(1. - cs, 2.*ngen))/chiN < 1.4 + 2./(n + 1.)) ? 1. : 0.;
+    pc = (1. - cc)*pc + hsig*sqrt(cc*(2. - cc)*mueff)*dm;
+    
+    mat artmp = (Ysel - repmat(m_old, 1, nsel))/sigma;
+    C = (1. - c1 - cmu)*C + c1*(pc*pc.t() + (1. - hsig)*cc*(2. - cc)*C) + cmu*artmp*diagmat(w)*artmp.t();
+    sigma *= exp((cs/damps)*(norm(ps)/chiN - 1.));
+    
+    vec eigval;
+    C = symmatu(C);
+    if (!eig_sym(eigval, B, C)) {
+        B = eye(n,n);
+        eigval = C.diag();
+    }
+    D = sqrt(clamp(eigval, sim_iota, datum::inf));
+}
+
+//-------------------------------------------------------------
+bool cmaes::stop() const
+//-------------------------------------------------------------
+{
+    //Converged step, ill-conditioned covariance, or no improvement for 10 + 30n/lambda generations
+    if (sigma*max(D) < tolx_cmaes)
+        return true;
+    if (max(D) > 1.E7*min(D))
+        return true;
+    if (stagnation > 10 + (30*n)/lambda)
+        return true;
+    return false;
+}
+
+//-------------------------------------------------------------
+void cmaes::restart(const vec &m0)
+//-------------------------------------------------------------
+{
+    m = clamp(m0, 0., 1.);
+    sigma = sigma0;
+    C = eye(n,n);
+    B = eye(n,n);
+    D = ones(n);
+    pc = zeros(n);
+    ps = zeros(n);
+    ngen = 0;
+    best_cost = datum::inf;
+    stagnation = 0;
+    restarts++;
+}
+
+//----------------------------------------------------------------------
+cmaes& cmaes::operator = (const cmaes& es)
+//----------------------------------------------------------------------
+{
+    n = es.n;
+    lambda = es.lambda;
+    mu = es.mu;
+    weights = es.weights;
+    mueff = es.mueff;
+    cc = es.cc;
+    cs = es.cs;
+    c1 = es.c1;
+    cmu = es.cmu;
+    damps = es.damps;
+    chiN = es.chiN;
+    min_values = es.min_values;
+    ranges = es.ranges;
+    m = es.m;
+    sigma = es.sigma;
+    sigma0 = es.sigma0;
+    C = es.C;
+    B = es.B;
+    D = es.D;
+    pc = es.pc;
+    ps = es.ps;
+    ngen = es.ngen;
+    restarts = es.restarts;
+    best_cost = es.best_cost;
+    stagnation = es.stagnation;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const cmaes& es)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the CMA-ES\n";
+    s << "Number of parameters: " << es.n << "\t individuals: " << es.lambda << "\t selected: " << es.mu << "\n";
+    s << "Mean (normalized): " << es.m.t();
+    s << "Step size: " << es.sigma << "\n";
+    s << "Generations: " << es.ngen << "\t restarts: " << es.restarts << "\n\n";
+    
+    return s;
+}
+
+} //namespace simcoon
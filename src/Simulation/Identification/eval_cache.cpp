@@ -0,0 +1,261 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file eval_cache.cpp
+///@brief Cache of the numerical vectors of the parameter sets already evaluated during an identification
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <set>
+#include <math.h>
+#include <armadillo>
+#include <boost/filesystem.hpp>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Identification/parameters.hpp>
+#include <simcoon/Simulation/Identification/constants.hpp>
+#include <simcoon/Simulation/Identification/eval_cache.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+//FNV-1a hash, stable from one run to another
+static unsigned long long hash_text(const string &text, unsigned long long h) {
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static string read_text(const string &path) {
+    ifstream in_file(path, ios::in | ios::binary);
+    stringstream buffer;
+    buffer << in_file.rdbuf();
+    return buffer.str();
+}
+    
+//=====Private methods for eval_cache===================================
+
+//=====Public methods for eval_cache============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+eval_cache::eval_cache()
+//-------------------------------------------------------------
+{
+    quantum = quantum_cache_identification;
+    signature = 0;
+    hits = 0;
+}
+
+/*!
+ \brief Constructor
+ \param params : parameters identified (their ranges define the quantization)
+ \param consts : constants of the identification
+ \param path_keys : folder of the files with keys
+ \param path_data : folder of the data
+ \param sizev : size of the numerical vector
+ \param mquantum : quantization step of the parameters, relative to their range
+ The signature gathers the files with keys, the other files of path_data, the ranges of the parameters and the size of the numerical vector, so that a cache saved for another problem is not used
+ */
+
+//-------------------------------------------------------------
+eval_cache::eval_cache(const vector<parameters> &params, const vector<constants> &consts, const string &path_keys, const string &path_data, const int &sizev, const double &mquantum)
+//-------------------------------------------------------------
+{
+    quantum = mquantum;
+    hits = 0;
+    min_values = zeros(params.size());
+    ranges = zeros(params.size());
+    
+    signature = 14695981039346656037ULL;
+    std::set<string> files;
+    for (unsigned int j=0; j<params.size(); j++) {
+        min_values(j) = params[j].min_value;
+        ranges(j) = params[j].max_value - params[j].min_value;
+        signature = hash_text(params[j].key + " " + to_string(params[j].min_value) + " " + to_string(params[j].max_value) + "\n", signature);
+        files.insert(params[j].input_files.begin(), params[j].input_files.end());
+    }
+    for (auto &co : consts) {
+        signature = hash_text(co.key + "\n", signature);
+        for (unsigned int i=0; i<co.input_values.n_elem; i++)
+            signature = hash_text(to_string(co.input_values(i)) + " ", signature);
+        files.insert(co.input_files.begin(), co.input_files.end());
+    }
+    signature = hash_text(to_string(sizev) + "\n", signature);
+    
+    for (auto &f : files)
+        signature = hash_text(f + "\n" + read_text(path_keys + "/" + f), signature);
+    
+    //The files of path_data without keys (sorted by name)
+    std::set<string> data_files;
+    if (boost::filesystem::is_directory(path_data)) {
+        for (boost::filesystem::directory_iterator end_dir_it, it(path_data); it!=end_dir_it; ++it) {
+            string f = it->path().filename().string();
+            if ((boost::filesystem::is_regular_file(it->path()))&&(files.count(f) == 0))
+                data_files.insert(f);
+        }
+    }
+    for (auto &f : data_files)
+        signature = hash_text(f + "\n" + read_text(path_data + "/" + f), signature);
+}
+
+/*!
+ \brief Copy constructor
+ \param ec eval_cache object to duplicate
+ */
+
+//------------------------------------------------------
+eval_cache::eval_cache(const eval_cache& ec)
+//------------------------------------------------------
+{
+    quantum = ec.quantum;
+    min_values = ec.min_values;
+    ranges = ec.ranges;
+    signature = ec.signature;
+    vnums = ec.vnums;
+    hits = ec.hits;
+}
+
+/*!
+ \brief destructor
+ */
+
+eval_cache::~eval_cache() {}
+
+//-------------------------------------------------------------
+vector<double> eval_cache::key(const vec &p) const
+//-------------------------------------------------------------
+{
+    vector<double> k(p.n_elem);
+    for (unsigned int j=0; j<p.n_elem; j++) {
+        double scale = ((j < ranges.n_elem)&&(ranges(j) > 0.)) ? quantum*ranges(j) : quantum;
+        double origin = (j < min_values.n_elem) ? min_values(j) : 0.;
+        k[j] = round((p(j) - origin)/scale);
+    }
+    return k;
+}
+
+//-------------------------------------------------------------
+bool eval_cache::find(const vec &p, vec &vnum)
+//-------------------------------------------------------------
+{
+    auto it = vnums.find(key(p));
+    if (it == vnums.end())
+        return false;
+    
+    vnum = it->second;
+    hits++;
+    return true;
+}
+
+//-------------------------------------------------------------
+void eval_cache::insert(const vec &p, const vec &vnum)
+//-------------------------------------------------------------
+{
+    vnums[key(p)] = vnum;
+}
+
+//-------------------------------------------------------------
+bool eval_cache::save(const string &filename) const
+//-------------------------------------------------------------
+{
+    std::ofstream file(filename, ios::binary);
+    if (!file)
+        return false;
+    
+    unsigned int n_param = min_values.n_elem;
+    unsigned int sizev = (vnums.empty()) ? 0 : vnums.begin()->second.n_elem;
+    mat keys = zeros(n_param, size());
+    mat values = zeros(sizev, size());
+    unsigned int i = 0;
+    for (auto &v : vnums) {
+        keys.col(i) = vec(v.first);
+        values.col(i) = v.second;
+        i++;
+    }
+    
+    file << "SIMCOON_EVAL_CACHE\n";
+    file << signature << " " << quantum << "\n";
+    bool ok = keys.save(file, arma_binary);
+    ok = ok && values.save(file, arma_binary);
+    return ok;
+}
+
+//-------------------------------------------------------------
+bool eval_cache::load(const string &filename)
+//-------------------------------------------------------------
+{
+    std::ifstream file(filename, ios::binary);
+    string header;
+    if ((!file)||(!getline(file, header))||(header != "SIMCOON_EVAL_CACHE"))
+        return false;
+    
+    unsigned long long msignature = 0;
+    double mquantum = 0.;
+    string line;
+    getline(file, line);
+    istringstream(line) >> msignature >> mquantum;
+    if ((msignature != signature)||(fabs(mquantum - quantum) > 1.E-6*quantum))
+        return false;
+    
+    mat keys;
+    mat values;
+    bool ok = keys.load(file, arma_binary);
+    ok = ok && values.load(file, arma_binary);
+    if ((!ok)||(keys.n_rows != min_values.n_elem)||(keys.n_cols != values.n_cols))
+        return false;
+    
+    for (unsigned int i=0; i<keys.n_cols; i++) {
+        vec k = keys.col(i);
+        vnums[vector<double>(k.begin(), k.end())] = values.col(i);
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+eval_cache& eval_cache::operator = (const eval_cache& ec)
+//----------------------------------------------------------------------
+{
+    quantum = ec.quantum;
+    min_values = ec.min_values;
+    ranges = ec.ranges;
+    signature = ec.signature;
+    vnums = ec.vnums;
+    hits = ec.hits;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const eval_cache& ec)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the cache of evaluations\n";
+    s << "Number of parameter sets: " << ec.size() << "\n";
+    s << "Number of evaluations found in the cache: " << ec.hits << "\n";
+    s << "Quantization step (relative to the ranges): " << ec.quantum << "\n\n";
+    
+    return s;
+}
+
+} //namespace simcoon
@@ -28,22 +28,45 @@
 #include <boost/filesystem.hpp>
 #include <simcoon/parameter.hpp>
 #include <simcoon/Simulation/Maths/random.hpp>
+#include <simcoon/Simulation/Maths/parallel.hpp>
 #include <simcoon/Simulation/Identification/parameters.hpp>
 #include <simcoon/Simulation/Identification/constants.hpp>
 #include <simcoon/Simulation/Identification/optimize.hpp>
 #include <simcoon/Simulation/Identification/generation.hpp>
 #include <simcoon/Simulation/Identification/methods.hpp>
+#include <simcoon/Simulation/Identification/cmaes.hpp>
 #include <simcoon/Simulation/Identification/opti_data.hpp>
 #include <simcoon/Simulation/Identification/doe.hpp>
 #include <simcoon/Simulation/Identification/read.hpp>
+#include <simcoon/Simulation/Identification/eval_cache.hpp>
 #include <simcoon/Simulation/Identification/script.hpp>
 
 using namespace std;
 using namespace arma;
 
 namespace simcoon{
-        
-void run_identification(const std::string &simul_type, const int &n_param, const int &n_consts, const int &nfiles, const int &ngen, const int &aleaspace, int &apop, int &spop, const int &ngboys, const int &maxpop, const int &stationnarity_nb, const double &stationnarity_lim, const std::string &path_data, const std::string &path_keys, const std::string &path_results, const std::string &materialfile, const std::string &outputfile, const std::string &data_num_name, const double &probaMut, const double &pertu, const double &c, const double &p0, const double &lambdaLM) {
+
+//Check if the material of the simulations is defined by a multiscale umat (MI...)
+static bool multiscale_umat(const string &path_data, const string &path_keys, const string &materialfile) {
+    
+    string buffer;
+    string umat_name;
+    ifstream propsmat;
+    
+    propsmat.open(path_keys + "/" + materialfile, ios::in);
+    if(!propsmat) {
+        propsmat.clear();
+        propsmat.open(path_data + "/" + materialfile, ios::in);
+    }
+    if(propsmat) {
+        propsmat >> buffer >> buffer >> umat_name;
+    }
+    propsmat.close();
+    
+    return (umat_name.substr(0,2) == "MI");
+}
+    
+void run_identification(const std::string &simul_type, const int &n_param, const int &n_consts, const int &nfiles, const int &ngen, const int &aleaspace, int &apop, int &spop, const int &ngboys, const int &maxpop, const int &stationnarity_nb, const double &stationnarity_lim, const std::string &path_data, const std::string &path_keys, const std::string &path_results, const std::string &materialfile, const std::string &outputfile, const std::string &data_num_name, const double &probaMut, const double &pertu, const double &c, const double &p0, const double &lambdaLM, const std::string &method) {
 
     std::string data_num_ext = data_num_name.substr(data_num_name.length()-4,data_num_name.length());
     std::string data_num_name_root = data_num_name.substr(0,data_num_name.length()-4); //to remove the extension
@@ -78,6 +101,15 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         }
     }
     
+    if((method != "GA")&&(method != "SSGA")&&(method != "DE")&&(method != "CMAES")) {
+        cout << "The optimization method " << method << " does not exist (GA : genetic algorithm, SSGA : asynchronous steady-state genetic algorithm, DE : differential evolution, CMAES : covariance matrix adaptation evolution strategy)\n";
+        exit(0);
+    }
+    if((method == "DE")&&(maxpop < 4)) {
+        cout << "Please increase the max number population per subgeneration to at least 4 for the differential evolution\n";
+        exit(0);
+    }
+    
     if(ngboys > maxpop) {
         cout << "Please increase the the max number population per subgeneration or reduce the number of gboys\n";
         exit(0);
@@ -85,6 +117,7 @@ void run_identification(const std::string &simul_type, const int &n_param, const
     
     ///Allow non-repetitive pseudo-random number generation
     srand(time(0));
+    arma_rng::set_seed(time(0));
     ofstream result;    ///Output stream, with parameters values and cost function
 
     //Define the parameters
@@ -168,15 +201,24 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         boost::filesystem::create_directory(data_num_folder);
     }
     
-    /// Run the simulations corresponding to each individual
-    /// The simulation input files should be ready!
-    for(int i=0; i<geninit.size(); i++) {
-        
-        run_simulation(simul_type, geninit.pop[i], nfiles, params, consts, data_num, data_num_folder, data_num_name, path_data, path_keys, materialfile);
-        
-        //Calculation of the cost function
-        geninit.pop[i].cout = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+    //The individuals are evaluated concurrently, each worker in its own copy of the data and numerical data folders
+    unsigned int nworkers = (nworkers_identification > 0) ? nworkers_identification : default_thread_pool().size();
+    if((nworkers > 1)&&(simul_type == "SOLVE")&&(multiscale_umat(path_data, path_keys, materialfile))) {
+        cout << "The multiscale umats read their phase files in the folder data: the individuals are evaluated sequentially" << endl;
+        nworkers = 1;
     }
+    setup_workers(nworkers, path_data, data_num_folder);
+    
+    //Cache of the parameter sets already evaluated, possibly saved by a previous identification of the same problem
+    eval_cache cache(params, consts, path_keys, path_data, sizev);
+    string cache_file = path_results + "/eval_cache.bin";
+    if((persist_cache_identification)&&(cache.load(cache_file))) {
+        cout << "The cache of evaluations " << cache_file << " has been loaded: " << cache.size() << " parameter sets" << endl;
+    }
+    
+    /// Run the simulations corresponding to each individual and compute the cost function
+    /// The simulation input files should be ready!
+    run_generation(simul_type, geninit, nfiles, params, consts, data_num, data_exp, vexp, W, sizev, data_num_folder, data_num_name, path_data, path_keys, materialfile, cache, nworkers);
     
     //Classification of bests
     for(int i=0; i<maxpop; i++) {
@@ -203,7 +245,12 @@ void run_identification(const std::string &simul_type, const int &n_param, const
     // Here we can choose the type of optimizer we want
     ///Creation of the generation table
     generation gensons(maxpop, n_param, id0);
-    generation n_gboys(n_param, n_param, id0);
+    
+    //The CMA-ES distribution starts from the best individual of the initial generation
+    cmaes es;
+    if((method == "CMAES")&&(maxpop > 1)) {
+        es = cmaes(params, maxpop, gen[0].pop[0].p);
+    }
     
     //get the first gboys to be optimized via gradient_based
     for(int i=0; i<ngboys; i++) {
@@ -214,6 +261,7 @@ void run_identification(const std::string &simul_type, const int &n_param, const
     
     std::vector<double> cost_gb_cost_n(ngboys);
     std::vector<vec> Dp_gb_n(ngboys);
+    std::vector<vec> delta_gb(ngboys);     //perturbations of the sensitivity matrices
     
     for(int i=0; i<ngboys; i++) {
         Dp_gb_n[i] = zeros(n_param);
@@ -230,13 +278,32 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         /// The simulation input files should be ready!
         if (maxpop > 1) {
             
-            genetic(gen[g], gensons, idnumber, probaMut, pertu, params);
+            if(method == "SSGA") {
+                //The sons are bred and evaluated asynchronously, the population being updated after each evaluation
+                run_steady_state(simul_type, gen[g], gensons, idnumber, probaMut, pertu, nfiles, params, consts, data_num, data_exp, vexp, W, sizev, data_num_folder, data_num_name, path_data, path_keys, materialfile, cache, nworkers);
+            }
+            else if(method == "DE")
+                differential_evolution(gen[g], gensons, idnumber, F_differential_evolution, CR_differential_evolution, params);
+            else if(method == "CMAES")
+                es.sample(gensons, idnumber);
+            else
+                genetic(gen[g], gensons, idnumber, probaMut, pertu, params);
             ///prepare the individuals to run
             
-            for(int i=0; i<gensons.size(); i++) {
-                run_simulation(simul_type, gensons.pop[i], nfiles, params, consts, data_num, data_num_folder, data_num_name, path_data, path_keys, materialfile);
-                //Calculation of the cost function
-                gensons.pop[i].cout = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+            if(method != "SSGA")
+                run_generation(simul_type, gensons, nfiles, params, consts, data_num, data_exp, vexp, W, sizev, data_num_folder, data_num_name, path_data, path_keys, materialfile, cache, nworkers);
+            
+            if(method == "CMAES") {
+                es.update(gensons);
+                //Restart from a random point of the parameter space when the distribution has converged or stagnates
+                if(es.stop()) {
+                    vec m0 = zeros(n_param);
+                    for(int j=0; j<n_param; j++) {
+                        m0(j) = alead(0.,1.);
+                    }
+                    es.restart(m0);
+                    cout << "CMA-ES restart number " << es.restarts << "\n";
+                }
             }
             
         }
@@ -244,7 +311,7 @@ void run_identification(const std::string &simul_type, const int &n_param, const
             
             cost_gb_cost_n[i] = gen[g].pop[i].cout;
             
-            S = calc_sensi(gboys[g].pop[i], n_gboys, simul_type, nfiles, n_param, params, consts, vnum, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, sizev, Dp_gb_n[i], materialfile);
+            S = calc_sensi(gboys[g].pop[i], simul_type, nfiles, n_param, params, consts, vnum, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, sizev, Dp_gb_n[i], delta_gb[i], materialfile, cache, nworkers);
             gboys[g].pop[i].cout = calcC(vexp, vnum, W);
             p = gboys[g].pop[i].p;
             ///Compute the parameters increment
@@ -275,7 +342,10 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         
         ///Find the bests
         g++;
-        find_best(gen[g], gboys[g], gen[g-1], gboys[g-1], gensons, maxpop, n_param, id0);
+        if((method == "DE")&&(maxpop > 1))
+            select_trials(gen[g], gboys[g], gen[g-1], gboys[g-1], gensons, maxpop, n_param, id0);
+        else
+            find_best(gen[g], gboys[g], gen[g-1], gboys[g-1], gensons, maxpop, n_param, id0);
         write_results(result, outputfile, gen[g], g, maxpop, n_param);
         
         if(fabs(costnm1 - gen[g].pop[0].cout) < sim_iota) {
@@ -315,6 +385,13 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         apply_parameters(params, path_results);
     }
     
+    clean_workers(nworkers, path_data, data_num_folder);
+    
+    if(cache_identification) {
+        cout << "Evaluations found in the cache of parameter sets: " << cache.hits << endl;
+        if(persist_cache_identification)
+            cache.save(cache_file);
+    }
 }
 
 } //namespace simcoon
@@ -0,0 +1,212 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file key_template.cpp
+///@brief Input files of the identification, parsed once with the slots of the keys of parameters and constants
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <mutex>
+#include <ctime>
+#include <boost/filesystem.hpp>
+#include <simcoon/Simulation/Identification/parameters.hpp>
+#include <simcoon/Simulation/Identification/constants.hpp>
+#include <simcoon/Simulation/Identification/key_template.hpp>
+
+using namespace std;
+
+namespace simcoon{
+
+//Templates read from files, with the modification time of the file and the keys they were parsed with
+struct shared_key_template {
+    std::shared_ptr<const key_template> tpl;
+    std::time_t time_file;
+    std::vector<string> keys;
+};
+static std::map<string, shared_key_template> shared_key_templates;
+static std::mutex shared_key_templates_mutex;
+
+static std::time_t file_time(const string &path) {
+    boost::system::error_code ec;
+    std::time_t t = boost::filesystem::last_write_time(path, ec);
+    return (ec) ? 0 : t;
+}
+    
+//=====Private methods for key_template===================================
+
+//=====Public methods for key_template============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+key_template::key_template()
+//-------------------------------------------------------------
+{
+    tokens.push_back("");
+}
+
+/*!
+ \brief Constructor from a file
+ \param path : folder of the file
+ \param mfile : name of the file
+ \param keys : keys to find in the file. When several keys start at the same position, the longest one is kept
+ */
+
+//-------------------------------------------------------------
+key_template::key_template(const string &path, const string &mfile, const vector<string> &keys)
+//-------------------------------------------------------------
+{
+    file = mfile;
+    
+    ifstream in_file;
+    in_file.open(path + "/" + file, ios::in);
+    if(!in_file) {
+        cout << "Error: cannot open the file " << file << " in the folder :" << path << endl;
+        tokens.push_back("");
+        return;
+    }
+    stringstream buffer;
+    buffer << in_file.rdbuf();
+    in_file.close();
+    string text = buffer.str();
+    
+    size_t pos = 0;
+    while(pos <= text.length()) {
+        size_t pos_key = string::npos;
+        unsigned int nkey = 0;
+        for(unsigned int i=0; i<keys.size(); i++) {
+            if(keys[i].empty())
+                continue;
+            size_t p = text.find(keys[i], pos);
+            if((p < pos_key)||((p == pos_key)&&(p != string::npos)&&(keys[i].length() > keys[nkey].length()))) {
+                pos_key = p;
+                nkey = i;
+            }
+        }
+        if(pos_key == string::npos) {
+            tokens.push_back(text.substr(pos));
+            break;
+        }
+        tokens.push_back(text.substr(pos, pos_key - pos));
+        slots.push_back(keys[nkey]);
+        pos = pos_key + keys[nkey].length();
+    }
+}
+
+/*!
+ \brief Copy constructor
+ \param kt key_template object to duplicate
+ */
+
+//------------------------------------------------------
+key_template::key_template(const key_template& kt)
+//------------------------------------------------------
+{
+    file = kt.file;
+    tokens = kt.tokens;
+    slots = kt.slots;
+}
+
+/*!
+ \brief destructor
+ */
+
+key_template::~key_template() {}
+
+//-------------------------------------------------------------
+string key_template::apply(const map<string, string> &values) const
+//-------------------------------------------------------------
+{
+    string text = tokens[0];
+    for(unsigned int i=0; i<slots.size(); i++) {
+        auto it = values.find(slots[i]);
+        text += (it != values.end()) ? it->second : slots[i];
+        text += tokens[i+1];
+    }
+    return text;
+}
+
+//-------------------------------------------------------------
+void key_template::write(const string &path, const map<string, string> &values) const
+//-------------------------------------------------------------
+{
+    ofstream ou_file;
+    ou_file.open(path + "/" + file);
+    ou_file << apply(values);
+    ou_file.close();
+}
+
+//-------------------------------------------------------------
+std::shared_ptr<const key_template> key_template::shared(const string &path, const string &mfile, const vector<string> &keys)
+//-------------------------------------------------------------
+{
+    string path_file = path + "/" + mfile;
+    std::time_t time_file = file_time(path_file);
+    
+    std::lock_guard<std::mutex> lock(shared_key_templates_mutex);
+    auto it = shared_key_templates.find(path_file);
+    if((it != shared_key_templates.end())&&(it->second.time_file == time_file)&&(it->second.keys == keys))
+        return it->second.tpl;
+    
+    shared_key_template skt;
+    skt.tpl = std::make_shared<const key_template>(path, mfile, keys);
+    skt.time_file = time_file;
+    skt.keys = keys;
+    shared_key_templates[path_file] = skt;
+    return skt.tpl;
+}
+
+//----------------------------------------------------------------------
+key_template& key_template::operator = (const key_template& kt)
+//----------------------------------------------------------------------
+{
+    file = kt.file;
+    tokens = kt.tokens;
+    slots = kt.slots;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const key_template& kt)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the key template\n";
+    s << "File: " << kt.file << "\n";
+    s << "Number of keys: " << kt.size() << "\n";
+    for(unsigned int i=0; i<kt.size(); i++) {
+        s << kt.slots[i] << "\t";
+    }
+    s << "\n\n";
+    
+    return s;
+}
+    
+map<string, string> key_values(const vector<parameters> &params, const vector<constants> &consts) {
+    
+    map<string, string> values;
+    for(auto &pa : params)
+        values[pa.key] = to_string(pa.value);
+    for(auto &co : consts)
+        values[co.key] = to_string(co.value);
+    return values;
+}
+
+} //namespace simcoon
@@ -24,8 +24,10 @@
 #include <fstream>
 #include <assert.h>
 #include <math.h>
+#include <mutex>
 #include <armadillo>
 #include <simcoon/Simulation/Maths/random.hpp>
+#include <simcoon/Simulation/Maths/parallel.hpp>
 #include <simcoon/Simulation/Maths/lagrange.hpp>
 #include <simcoon/Simulation/Identification/parameters.hpp>
 #include <simcoon/Simulation/Identification/methods.hpp>
@@ -37,47 +39,157 @@ using namespace arma;
 
 namespace simcoon{
     
+//Breed an individual from two random parents among the npop first individuals of a generation (crossover, perturbation and mutation)
+void breed(const generation &gen_g, individual &son, const int &npop, const double &probaMut, const double &pertu, const vector<parameters> &params){
+    
+    int n_param = params.size();
+    
+    int chromosome = 0;
+    /// Random determination of "father" and "mother"
+    individual dad = gen_g.pop[alea(npop-1)];
+    individual mom = gen_g.pop[alea(npop-1)];
+    while(dad.id==mom.id)
+        mom = gen_g.pop[alea(npop-1)];
+    
+    for(int j=0; j<n_param; j++) {
+        chromosome = alea(1);
+        if(chromosome==0) {
+            son.p(j)=dad.p(j)*alead(1.-pertu,1.+pertu);
+        }
+        else {
+            son.p(j)=mom.p(j)*alead(1.-pertu,1.+pertu);
+        }
+        
+        if (son.p(j) > params[j].max_value)
+            son.p(j) = params[j].max_value;
+        if (son.p(j) < params[j].min_value)
+            son.p(j) = params[j].min_value;
+        
+        ///Apply a mutation
+        if (alea(99)<probaMut)
+            son.p(j) = alead(params[j].min_value, params[j].max_value);
+    }
+}
+    
 //Genetic method
 void genetic(generation &gen_g, generation &gensons, int &idnumber, const double &probaMut, const double &pertu, const vector<parameters> &params){
     
-    int n_param = params.size();
     int maxpop = gensons.size();
     
-    //Generate two genitoers
-	individual dad(n_param, 0, 0.);
-	individual mom(n_param, 0, 0.);
+    gensons.newid(idnumber);
+    for(int i=0; i<maxpop; i++) {
+        breed(gen_g, gensons.pop[i], maxpop, probaMut, pertu, params);
+    }
+    
+}
 
-    int chromosome = 0;
-    //Very small pertubation
+//Differential evolution (DE/rand/1/bin) : a trial individual is built for each individual of the current generation, select_trials then keeps the better of each trial/target pair
+void differential_evolution(const generation &gen_g, generation &gensons, int &idnumber, const double &F, const double &CR, const vector<parameters> &params){
+    
+    int n_param = params.size();
+    int maxpop = gensons.size();
+    int npop = gen_g.size();
+    assert(npop > 3);
     
     gensons.newid(idnumber);
     for(int i=0; i<maxpop; i++) {
-        /// Random determination of "father" and "mother"
-        dad = gen_g.pop[alea(maxpop-1)];
-        mom = gen_g.pop[alea(maxpop-1)];
-        while(dad.id==mom.id)
-            mom = gen_g.pop[alea(maxpop-1)];
-            
+        /// Random determination of three distinct individuals, different from the target
+        int t = i%npop;
+        int r1 = alea(npop-1);
+        while(r1==t)
+            r1 = alea(npop-1);
+        int r2 = alea(npop-1);
+        while((r2==t)||(r2==r1))
+            r2 = alea(npop-1);
+        int r3 = alea(npop-1);
+        while((r3==t)||(r3==r1)||(r3==r2))
+            r3 = alea(npop-1);
+        
+        ///At least one parameter comes from the mutant
+        int jrand = (n_param > 1) ? alea(n_param-1) : 0;
         for(int j=0; j<n_param; j++) {
-            chromosome = alea(1);
-            if(chromosome==0) {
-                gensons.pop[i].p(j)=dad.p(j)*alead(1.-pertu,1.+pertu);
+            if((j==jrand)||(alead(0.,1.) < CR)) {
+                gensons.pop[i].p(j) = gen_g.pop[r1].p(j) + F*(gen_g.pop[r2].p(j) - gen_g.pop[r3].p(j));
             }
             else {
-                gensons.pop[i].p(j)=mom.p(j)*alead(1.-pertu,1.+pertu);
+                gensons.pop[i].p(j) = gen_g.pop[t].p(j);
             }
-                
+            
+            ///Out of the bounds, the parameter is set between the target and the bound
             if (gensons.pop[i].p(j) > params[j].max_value)
-                gensons.pop[i].p(j) = params[j].max_value;
+                gensons.pop[i].p(j) = 0.5*(gen_g.pop[t].p(j) + params[j].max_value);
             if (gensons.pop[i].p(j) < params[j].min_value)
-                gensons.pop[i].p(j) = params[j].min_value;
+                gensons.pop[i].p(j) = 0.5*(gen_g.pop[t].p(j) + params[j].min_value);
+        }
+    }
+    
+}
+
+//Steady-state genetic method : the population is updated after each evaluation
+void steady_state(generation &pop, generation &gensons, int &idnumber, const double &probaMut, const double &pertu, const vector<parameters> &params, const unsigned int &nworkers, const std::function<double(const individual &, const unsigned int &)> &cost){
+    
+    unsigned int n = gensons.size();
+    unsigned int nw = std::min(std::max(nworkers, 1u), n);
+    unsigned int next = 0;
+    std::mutex mtx;
+    
+    auto work = [&](const unsigned int &k) {
+        while(true) {
+            unsigned int i = 0;
+            individual son;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if(next >= n)
+                    return;
+                i = next++;
+                son = gensons.pop[i];
+                breed(pop, son, pop.size(), probaMut, pertu, params);
+                son.id = idnumber++;
+            }
+            
+            son.cout = cost(son, k);
             
-            ///Apply a mutation
-            if (alea(99)<probaMut)
-                gensons.pop[i].p(j) = alead(params[j].min_value, params[j].max_value);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                gensons.pop[i] = son;
+                
+                //The new individual replaces the worst one of the population if it is better (failed evaluations are dropped)
+                individual &worst = pop.pop[pop.size()-1];
+                if((!std::isnan(son.cout))&&((std::isnan(worst.cout))||(son.cout < worst.cout))) {
+                    worst = son;
+                    pop.classify();
+                }
+            }
         }
+    };
+    
+    if(nw < 2)
+        work(0);
+    else
+        parallel_for(nw, work);
+}
+
+//Selection of the differential evolution : each trial individual replaces its target if its cost is not greater (the gboys being the targets of the first trials)
+void select_trials(generation &gen_cur, generation &gboys_cur, const generation &gen_old, const generation &gboys_old, const generation &gensons, const int &maxpop, const int &n_param, int& id0) {
+    
+    gen_cur.construct(maxpop, n_param, id0, 0.);
+    
+    if(gboys_old.size()) {
+        gboys_cur.construct(gboys_old.size(), n_param, id0, 0.);
+    }
+    
+    for(int i=0; i<maxpop; i++) {
+        const individual &target = (i < gboys_old.size()) ? gboys_old.pop[i] : gen_old.pop[i];
+        if((i < gensons.size())&&((gensons.pop[i].cout <= target.cout)||(std::isnan(target.cout))))
+            gen_cur.pop[i] = gensons.pop[i];
+        else
+            gen_cur.pop[i] = target;
     }
+    gen_cur.classify();
     
+    for(int i=0; i<gboys_cur.size(); i++) {
+        gboys_cur.pop[i] = gen_cur.pop[i];
+    }
 }
 
 void find_best(generation &gen_cur, generation &gboys_cur, const generation &gen_old, const generation &gboys_old, const generation &gensons, const int &maxpop, const int &n_param, int& id0) {
@@ -296,6 +296,12 @@ void ident_essentials(int &n_param, int &n_consts, int &n_files, const string &p
     
 void ident_control(int &ngen, int &aleaspace, int &apop, int &spop, int &ngboys, int &maxpop, int &station_nb, double &station_lim, double &probaMut, double &pertu, double &c, double &p0, double &lambdaLM, const string &path, const string &filename) {
     
+    string method;
+    ident_control(ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, station_lim, probaMut, pertu, c, p0, lambdaLM, method, path, filename);
+}
+    
+void ident_control(int &ngen, int &aleaspace, int &apop, int &spop, int &ngboys, int &maxpop, int &station_nb, double &station_lim, double &probaMut, double &pertu, double &c, double &p0, double &lambdaLM, string &method, const string &path, const string &filename) {
+    
     string pathfile = path + "/" + filename;
     ifstream param_control;
     string buffer;
@@ -330,6 +336,11 @@ void ident_control(int &ngen, int &aleaspace, int &apop, int &spop, int &ngboys,
     param_control >> buffer >> c >> p0;
     param_control >> buffer >> lambdaLM;
     
+    ///The optimization method is optional (genetic algorithm by default)
+    method = "GA";
+    if(!(param_control >> buffer >> method))
+        method = "GA";
+    
     param_control.close();
 }
     
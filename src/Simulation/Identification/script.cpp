@@ -26,16 +26,26 @@
 #include <armadillo>
 #include <algorithm>
 #include <map>
+#include <set>
+#include <sstream>
+#include <atomic>
+#include <mutex>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/parallel.hpp>
 #include <simcoon/Simulation/Identification/parameters.hpp>
 #include <simcoon/Simulation/Identification/constants.hpp>
 #include <simcoon/Simulation/Identification/generation.hpp>
 #include <simcoon/Simulation/Identification/read.hpp>
 #include <simcoon/Simulation/Identification/optimize.hpp>
+#include <simcoon/Simulation/Identification/key_template.hpp>
+#include <simcoon/Simulation/Identification/eval_cache.hpp>
+#include <simcoon/Simulation/Identification/methods.hpp>
 #include <simcoon/Simulation/Identification/script.hpp>
 #include <simcoon/Simulation/Solver/read.hpp>
 #include <simcoon/Simulation/Solver/solver.hpp>
+#include <simcoon/Simulation/Solver/column_buffer.hpp>
 #include <simcoon/Simulation/Phase/phase_characteristics.hpp>
 #include <simcoon/Simulation/Phase/read.hpp>
 #include <simcoon/Simulation/Phase/write.hpp>
@@ -150,64 +160,120 @@ void apply_constants(const vector<constants> &consts, const string &dst_path) {
     
 }
     
+map<string, string> key_files(const vector<parameters> &params, const vector<constants> &consts, const string &path_keys) {
+    
+    map<string, string> values = key_values(params, consts);
+    vector<string> keys;
+    for (auto &v : values)
+        keys.push_back(v.first);
+    
+    std::set<string> files;
+    for (auto &pa : params)
+        files.insert(pa.input_files.begin(), pa.input_files.end());
+    for (auto &co : consts)
+        files.insert(co.input_files.begin(), co.input_files.end());
+    
+    map<string, string> texts;
+    for (auto &f : files)
+        texts[f] = key_template::shared(path_keys, f, keys)->apply(values);
+    return texts;
+}
+
+void write_key_files(const map<string, string> &texts, const string &dst_path, const vector<string> &in_memory) {
+    
+    ofstream ou_files;
+    for (auto &t : texts) {
+        if((!write_keys_identification)&&(std::find(in_memory.begin(), in_memory.end(), t.first) != in_memory.end()))
+            continue;
+        ou_files.open(dst_path + "/" + t.first);
+        ou_files << t.second;
+        ou_files.close();
+    }
+}
+    
+//Material properties from the text of the material file if it holds keys, from the file in path_data otherwise
+static void read_matprops_keys(const map<string, string> &texts, string &umat_name, unsigned int &nprops, vec &props, unsigned int &nstatev, double &psi_rve, double &theta_rve, double &phi_rve, const string &path_data, const string &materialfile) {
+    
+    auto it = texts.find(materialfile);
+    if(it != texts.end()) {
+        istringstream propsmat(it->second);
+        read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, propsmat);
+    }
+    else
+        read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
+}
+    
+//Solve the test i for the individual ind, the keys being replaced in memory; the global results are written in the stream sptr_out if provided, in path_results/outputfile otherwise
+static void solve_keys(const individual &ind, const int &i, vector<parameters> &params, vector<constants> &consts, const string &path_results, const string &outputfile, const string &path_data, const string &path_keys, const string &materialfile, const std::shared_ptr<std::ostream> &sptr_out)
+{
+    string pathfile = "path_id_" + to_string(i+1) + ".txt";
+    
+    string umat_name;
+    unsigned int nprops = 0;
+    unsigned int nstatev = 0;
+    vec props;
+    
+    double psi_rve = 0.;
+    double theta_rve = 0.;
+    double phi_rve = 0.;
+    
+    //Replace the constants
+    for (unsigned int k=0; k<consts.size(); k++) {
+        consts[k].value = consts[k].input_values(i);
+    }
+    //Replace the parameters
+    for (unsigned int k=0; k<params.size(); k++) {
+        params[k].value = ind.p(k);
+    }
+    
+    //The material and loading path files are given to the solver in memory, the other files are written in path_data
+    map<string, string> texts = key_files(params, consts, path_keys);
+    write_key_files(texts, path_data, {materialfile, pathfile});
+    
+    int solver_type = 0;
+    int corate_type = 0;
+    
+    double div_tnew_dt_solver = 0.;
+    double mul_tnew_dt_solver = 0.;
+    int miniter_solver = 0;
+    int maxiter_solver = 0;
+    int inforce_solver = 0;
+    double precision_solver = 0.;
+    double lambda_solver = 0.;
+    
+    solver_essentials(solver_type, corate_type, path_data);
+    solver_control(div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data);
+    
+    //Then read the material properties and the loading path
+    read_matprops_keys(texts, umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
+    
+    std::vector<block> blocks;
+    double T_init = 0.;
+    auto it_path = texts.find(pathfile);
+    if(it_path != texts.end()) {
+        istringstream path(it_path->second);
+        read_path(blocks, T_init, path, path_data);
+    }
+    else
+        read_path(blocks, T_init, path_data, pathfile);
+    
+    ///Launching the solver with relevant parameters
+    solver(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, solver_type, corate_type, div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, blocks, T_init, path_data, path_results, outputfile, sptr_out);
+}
+    
 void launch_solver(const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, const string &path_results, const string &name, const string &path_data, const string &path_keys, const string &materialfile)
 {
 	string outputfile;
     string simulfile;
-	string pathfile;
     
     string name_ext = name.substr(name.length()-4,name.length());
     string name_root = name.substr(0,name.length()-4); //to remove the extension
     
-	//#pragma omp parallel for private(sstm, path)
     for (int i = 0; i<nfiles; i++) {
-        ///Creating the right path & output filenames
-        
+        ///Creating the right output filenames
         outputfile = name_root + "_" + to_string(ind.id) + "_" + to_string(i+1) + name_ext;
-        pathfile = "path_id_" + to_string(i+1) + ".txt";
-        
-        string umat_name;
-        unsigned int nprops = 0;
-        unsigned int nstatev = 0;
-        vec props;
-        
-        double psi_rve = 0.;
-        double theta_rve = 0.;
-        double phi_rve = 0.;
-                
-        //Replace the constants
-        for (unsigned int k=0; k<consts.size(); k++) {
-            consts[k].value = consts[k].input_values(i);
-        }
-        //Replace the parameters
-        for (unsigned int k=0; k<params.size(); k++) {
-            params[k].value = ind.p(k);
-        }
-        
-        copy_constants(consts, path_keys, path_data);
-        copy_parameters(params, path_keys, path_data);
         
-        apply_constants(consts, path_data);
-        apply_parameters(params, path_data);
-        
-        int solver_type = 0;
-        int corate_type = 0;
-        
-        double div_tnew_dt_solver = 0.;
-        double mul_tnew_dt_solver = 0.;
-        int miniter_solver = 0;
-        int maxiter_solver = 0;
-        int inforce_solver = 0;
-        double precision_solver = 0.;
-        double lambda_solver = 0.;
-        
-        solver_essentials(solver_type, corate_type, path_data);
-        solver_control(div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data);
-        
-        //Then read the material properties
-        read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
-        ///Launching the solver with relevant parameters
-        solver(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, solver_type, corate_type, div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data, path_results, pathfile, outputfile);
+        solve_keys(ind, i, params, consts, path_results, outputfile, path_data, path_keys, materialfile, std::shared_ptr<std::ostream>());
         
         //Get the simulation files according to the proper name
         outputfile = path_results + "/" + name_root + "_" + to_string(ind.id) + "_" + to_string(i+1) + "_global-0" + name_ext;
@@ -217,6 +283,26 @@ void launch_solver(const individual &ind, const int &nfiles, vector<parameters>
     }
 }
     
+void launch_solver(const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const string &path_results, const string &name, const string &path_data, const string &path_keys, const string &materialfile)
+{
+    string name_ext = name.substr(name.length()-4,name.length());
+    string name_root = name.substr(0,name.length()-4); //to remove the extension
+    
+    for (int i = 0; i<nfiles; i++) {
+        string outputfile = name_root + "_" + to_string(ind.id) + "_" + to_string(i+1) + name_ext;
+        
+        //The columns of files_num.inp are kept as the solver writes its global results
+        column_buffer buffer(data_num[i].c_data, data_num[i].skiplines);
+        std::shared_ptr<std::ostream> sptr_out = make_shared<std::ostream>(&buffer);
+        
+        solve_keys(ind, i, params, consts, path_results, outputfile, path_data, path_keys, materialfile, sptr_out);
+        
+        data_num[i].name = outputfile;
+        data_num[i].data = buffer.data();
+        data_num[i].ndata = data_num[i].data.n_rows;
+    }
+}
+    
 void launch_odf(const individual &ind, vector<parameters> &params, const string &path_results, const string &name, const string &path_data, const string &path_keys, const string &materialfile)
 {
 
@@ -232,8 +318,8 @@ void launch_odf(const individual &ind, vector<parameters> &params, const string
         params[k].value = ind.p(k);
     }
     
-    copy_parameters(params, path_keys, path_data);
-    apply_parameters(params, path_data);
+    map<string, string> texts = key_files(params, vector<constants>(), path_keys);
+    write_key_files(texts, path_data, {materialfile});
     
     string umat_name;
     unsigned int nprops;
@@ -244,7 +330,7 @@ void launch_odf(const individual &ind, vector<parameters> &params, const string
     vec props;
     
     //Then read the material properties
-    read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
+    read_matprops_keys(texts, umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
     phase_characteristics rve_init;
     rve_init.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, nprops, props);
     // The vector of props should be = {nphases_out,nscale,geom_type,npeak};
@@ -335,8 +421,8 @@ void launch_pdf(const individual &ind, vector<parameters> &params, const string
         params[k].value = ind.p(k);
     }
     
-    copy_parameters(params, path_keys, path_data);
-    apply_parameters(params, path_data);
+    map<string, string> texts = key_files(params, vector<constants>(), path_keys);
+    write_key_files(texts, path_data, {materialfile});
     
     string umat_name;
     unsigned int nprops;
@@ -347,7 +433,7 @@ void launch_pdf(const individual &ind, vector<parameters> &params, const string
     vec props;
     
     //Then read the material properties
-    read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
+    read_matprops_keys(texts, umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
     phase_characteristics rve_init;
     rve_init.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, nprops, props);
     
@@ -452,11 +538,7 @@ void launch_func_N(const individual &ind, const int &nfiles, vector<parameters>
             params[k].value = ind.p(k);
         }
         
-        copy_constants(consts, path_keys, path_data);
-        copy_parameters(params, path_keys, path_data);
-        
-        apply_constants(consts, path_data);
-        apply_parameters(params, path_data);
+        write_key_files(key_files(params, consts, path_keys), path_data);
         
         vec props;
         vec variables;
@@ -469,7 +551,7 @@ void launch_func_N(const individual &ind, const int &nfiles, vector<parameters>
     }
 }
     
-void run_simulation(const string &simul_type, const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile) {
+void run_simulation(const string &simul_type, const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile, const bool &in_memory) {
     
     //In the simulation run, make sure that we remove all the temporary files
     boost::filesystem::path path_to_remove(folder);
@@ -487,6 +569,11 @@ void run_simulation(const string &simul_type, const individual &ind, const int &
             break;
         }
         case 1: {
+            if(in_memory) {
+                //The numerical data are filled by the solver directly, there is no file to import
+                launch_solver(ind, nfiles, params, consts, data_num, folder, name, path_data, path_keys, inputdatafile);
+                return;
+            }
             launch_solver(ind, nfiles, params, consts, folder, name, path_data, path_keys, inputdatafile);
             break;
         }
@@ -527,42 +614,239 @@ double calc_cost(const vec &vexp, vec &vnum, const vec &W, const vector<opti_dat
     vnum = calcV(data_num, data_exp, nfiles, sizev);    
     return calcC(vexp, vnum, W);
 }
-     
-mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_type, const int &nfiles, const int &n_param, vector<parameters> &params, vector<constants> &consts, vec &vnum0, vector<opti_data> &data_num, vector<opti_data> &data_exp, const string &folder, const string &name, const string &path_data, const string &path_keys, const int &sizev, const vec &Dp_n, const string &materialfile) {
+
+//Copy the content of a folder (and of its subfolders) into another one
+static void copy_folder(const boost::filesystem::path &src, const boost::filesystem::path &dst) {
+    
+    boost::filesystem::create_directories(dst);
+    for (boost::filesystem::directory_iterator end_dir_it, it(src); it!=end_dir_it; ++it) {
+        boost::filesystem::path dst_file = dst / it->path().filename();
+        if(boost::filesystem::is_directory(it->path()))
+            copy_folder(it->path(), dst_file);
+        else
+            boost::filesystem::copy_file(it->path(),dst_file,boost::filesystem::copy_option::overwrite_if_exists);
+    }
+}
     
-    //delta
-    vec delta = 0.01*ones(n_param);
+string worker_path(const string &path, const unsigned int &k) {
     
-    mat S = zeros(sizev,n_param);
-    //genrun part of the gradient
+    string root = path;
+    while((root.length() > 1)&&(root.back() == '/'))
+        root.pop_back();
+    return root + "_w" + to_string(k);
+}
+
+void setup_workers(const unsigned int &nworkers, const string &path_data, const string &folder) {
     
-    run_simulation(simul_type, gboy, nfiles, params, consts, data_num, folder, name, path_data, path_keys, materialfile);
-    vnum0 = calcV(data_num, data_exp, nfiles, sizev);
+    if(nworkers < 2)
+        return;
     
-    for(int j=0; j<n_param; j++) {
-        n_gboy.pop[j].p = gboy.p;
-        if (fabs(Dp_n(j)) > 0.) {
-            delta(j) *= Dp_n(j);
-//            delta(j) *= (0.1*gboy.p(j));
-            n_gboy.pop[j].p(j) += delta(j);
+    for(unsigned int k=0; k<nworkers; k++) {
+        boost::filesystem::remove_all(worker_path(path_data, k));
+        copy_folder(path_data, worker_path(path_data, k));
+        boost::filesystem::create_directories(worker_path(folder, k));
+    }
+}
+    
+void clean_workers(const unsigned int &nworkers, const string &path_data, const string &folder) {
+    
+    if(nworkers < 2)
+        return;
+    
+    for(unsigned int k=0; k<nworkers; k++) {
+        boost::filesystem::remove_all(worker_path(path_data, k));
+        boost::filesystem::remove_all(worker_path(folder, k));
+    }
+}
+    
+void run_individuals(const generation &gen, const string &folder, const string &path_data, const unsigned int &nworkers, vector<vec> &vnum, const std::function<vec(const individual &, const string &, const string &, const unsigned int &)> &eval) {
+    
+    unsigned int n = gen.size();
+    unsigned int nw = std::min(nworkers, n);
+    vnum.resize(n);
+    
+    if(nw < 2) {
+        for(unsigned int i=0; i<n; i++) {
+            vnum[i] = eval(gen.pop[i], folder, path_data, 0);
         }
-        else {
-            delta(j) *= (0.1*gboy.p(j));
-            n_gboy.pop[j].p(j) += delta(j);
+        return;
+    }
+    
+    //Each worker k evaluates the next pending individual in its private data and results folders
+    std::atomic<unsigned int> next(0);
+    parallel_for(nw, [&](const unsigned int &k) {
+        string folder_w = worker_path(folder, k);
+        string path_data_w = worker_path(path_data, k);
+        
+        for(unsigned int i = next++; i<n; i = next++) {
+            vnum[i] = eval(gen.pop[i], folder_w, path_data_w, k);
         }
+    });
+}
+    
+void run_individuals(const string &simul_type, const generation &gen, const int &nfiles, const vector<parameters> &params, const vector<constants> &consts, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const int &sizev, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile, const unsigned int &nworkers, vector<vec> &vnum) {
+    
+    //Each worker runs the simulations with its own copy of the parameters, the constants and the numerical data
+    unsigned int nw = std::max(std::min(nworkers, (unsigned int)gen.size()), 1u);
+    vector<vector<parameters> > params_w(nw, params);
+    vector<vector<constants> > consts_w(nw, consts);
+    vector<vector<opti_data> > data_num_w(nw, data_num);
+    
+    run_individuals(gen, folder, path_data, nworkers, vnum, [&](const individual &ind, const string &folder_w, const string &path_data_w, const unsigned int &k) {
+        run_simulation(simul_type, ind, nfiles, params_w[k], consts_w[k], data_num_w[k], folder_w, name, path_data_w, path_keys, inputdatafile, memory_data_identification);
+        return calcV(data_num_w[k], data_exp, nfiles, sizev);
+    });
+}
+    
+void run_individuals(const string &simul_type, const generation &gen, const int &nfiles, const vector<parameters> &params, const vector<constants> &consts, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const int &sizev, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile, const unsigned int &nworkers, vector<vec> &vnum, eval_cache &cache) {
+    
+    if(!cache_identification) {
+        run_individuals(simul_type, gen, nfiles, params, consts, data_num, data_exp, sizev, folder, name, path_data, path_keys, inputdatafile, nworkers, vnum);
+        return;
     }
     
-    for(int j=0; j<n_param; j++) {
-        //run the simulation
-        run_simulation(simul_type, n_gboy.pop[j], nfiles, params, consts, data_num, folder, name, path_data, path_keys, materialfile);
-        vec vnum = calcV(data_num, data_exp, nfiles, sizev);
+    unsigned int n = gen.size();
+    vnum.assign(n, zeros(sizev));
+    
+    //Only the parameter sets that are neither in the cache nor repeated in the generation are run
+    generation gen_run;
+    vector<int> nrun(n, -1);
+    map<vector<double>, int> keys_run;
+    for(unsigned int i=0; i<n; i++) {
+        if(cache.find(gen.pop[i].p, vnum[i]))
+            continue;
+        auto it = keys_run.insert(make_pair(cache.key(gen.pop[i].p), gen_run.size()));
+        if(it.second)
+            gen_run.pop.push_back(gen.pop[i]);
+        else
+            cache.hits++;
+        nrun[i] = it.first->second;
+    }
+    
+    vector<vec> vnum_run;
+    if(gen_run.size() > 0)
+        run_individuals(simul_type, gen_run, nfiles, params, consts, data_num, data_exp, sizev, folder, name, path_data, path_keys, inputdatafile, nworkers, vnum_run);
+    
+    for(int i=0; i<gen_run.size(); i++) {
+        cache.insert(gen_run.pop[i].p, vnum_run[i]);
+    }
+    for(unsigned int i=0; i<n; i++) {
+        if(nrun[i] >= 0)
+            vnum[i] = vnum_run[nrun[i]];
+    }
+}
+    
+void run_generation(const string &simul_type, generation &gen, const int &nfiles, const vector<parameters> &params, const vector<constants> &consts, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const vec &vexp, const vec &W, const int &sizev, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile, eval_cache &cache, const unsigned int &nworkers) {
+    
+    vector<vec> vnum;
+    run_individuals(simul_type, gen, nfiles, params, consts, data_num, data_exp, sizev, folder, name, path_data, path_keys, inputdatafile, nworkers, vnum, cache);
+    
+    //Calculation of the cost function
+    for(int i=0; i<gen.size(); i++) {
+        gen.pop[i].cout = calcC(vexp, vnum[i], W);
+    }
+}
+     
+void run_steady_state(const string &simul_type, const generation &gen, generation &gensons, int &idnumber, const double &probaMut, const double &pertu, const int &nfiles, const vector<parameters> &params, const vector<constants> &consts, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const vec &vexp, const vec &W, const int &sizev, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile, eval_cache &cache, const unsigned int &nworkers) {
+    
+    generation pop = gen;     //Steady-state population, classified
+    unsigned int nw = std::min(std::max(nworkers, 1u), (unsigned int)gensons.size());
+    std::mutex mtx_cache;
+    
+    //Each worker evaluates the individuals in its private data and results folders, with its own copy of the parameters
+    vector<vector<parameters> > params_w(nw, params);
+    vector<vector<constants> > consts_w(nw, consts);
+    vector<vector<opti_data> > data_num_w(nw, data_num);
+    
+    auto cost = [&](const individual &son, const unsigned int &k) {
+        vec vnum;
+        bool cached = false;
+        if(cache_identification) {
+            std::lock_guard<std::mutex> lock(mtx_cache);
+            cached = cache.find(son.p, vnum);
+        }
         
-        calcS(S, vnum, vnum0, j, delta);
+        if(!cached) {
+            string folder_w = (nw < 2) ? folder : worker_path(folder, k);
+            string path_data_w = (nw < 2) ? path_data : worker_path(path_data, k);
+            run_simulation(simul_type, son, nfiles, params_w[k], consts_w[k], data_num_w[k], folder_w, name, path_data_w, path_keys, inputdatafile, memory_data_identification);
+            vnum = calcV(data_num_w[k], data_exp, nfiles, sizev);
+            if(cache_identification) {
+                std::lock_guard<std::mutex> lock(mtx_cache);
+                cache.insert(son.p, vnum);
+            }
+        }
+        return calcC(vexp, vnum, W);
+    };
+    
+    steady_state(pop, gensons, idnumber, probaMut, pertu, params, nworkers, cost);
+}
+    
+mat calc_sensi(const individual &gboy, const vector<parameters> &params, vec &vnum0, const vec &Dp_n, vec &delta, const std::function<void(const generation &, vector<vec> &)> &run, const bool &central) {
+    
+    int n_param = gboy.p.n_elem;
+    
+    //Perturbation of the parameters: from the last increment (or the parameter value if it did not change), or adapted since the last evaluation of S
+    if((!adaptive_sensi_identification)||(delta.n_elem != (unsigned int)n_param)) {
+        delta = zeros(n_param);
+        for(int j=0; j<n_param; j++) {
+            if (fabs(Dp_n(j)) > 0.)
+                delta(j) = delta_sensi_identification*Dp_n(j);
+            else
+                delta(j) = delta_sensi_identification*(0.1*gboy.p(j));
+            
+            if (fabs(delta(j)) < sim_iota)
+                delta(j) = delta_sensi_identification*(0.1*(params[j].max_value - params[j].min_value));
+        }
+    }
+    
+    //The individual itself, then the forward (and backward for central differences) perturbations, all evaluated concurrently
+    generation n_gboy;
+    n_gboy.pop.assign((central) ? 2*n_param+1 : n_param+1, gboy);
+    for(int j=0; j<n_param; j++) {
+        n_gboy.pop[1+j].p(j) += delta(j);
+        if (central)
+            n_gboy.pop[1+n_param+j].p(j) -= delta(j);
+    }
+    
+    vector<vec> vnum;
+    run(n_gboy, vnum);
+    vnum0 = vnum[0];
+    
+    mat S = zeros(vnum0.n_elem,n_param);
+    for(int j=0; j<n_param; j++) {
+        if (central)
+            calcS(S, vnum[1+j], vnum[1+n_param+j], j, 2.*delta);
+        else
+            calcS(S, vnum[1+j], vnum0, j, delta);
+    }
+    
+    //Adaptive perturbation: increased if the response did not change significantly (noise, flat S column), decreased if it changed too much (non-linearity)
+    if (adaptive_sensi_identification) {
+        double norm0 = std::max(norm(vnum0), sim_iota);
+        for(int j=0; j<n_param; j++) {
+            double range = params[j].max_value - params[j].min_value;
+            double dv = norm(S.col(j))*fabs(delta(j))/norm0;
+            if (dv < 1.E-6)
+                delta(j) *= 4.;
+            else if (dv > 1.E-2)
+                delta(j) *= 0.25;
+            
+            if (fabs(delta(j)) > 0.1*range)
+                delta(j) = (delta(j) > 0.) ? 0.1*range : -0.1*range;
+            else if (fabs(delta(j)) < 1.E-8*range)
+                delta(j) = (delta(j) < 0.) ? -1.E-8*range : 1.E-8*range;
+        }
     }
     return S;
 }
     
+mat calc_sensi(const individual &gboy, const string &simul_type, const int &nfiles, const int &n_param, const vector<parameters> &params, const vector<constants> &consts, vec &vnum0, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const string &folder, const string &name, const string &path_data, const string &path_keys, const int &sizev, const vec &Dp_n, vec &delta, const string &materialfile, eval_cache &cache, const unsigned int &nworkers) {
     
-    
+    assert(gboy.p.n_elem == (unsigned int)n_param);
+    return calc_sensi(gboy, params, vnum0, Dp_n, delta, [&](const generation &n_gboy, vector<vec> &vnum) {
+        run_individuals(simul_type, n_gboy, nfiles, params, consts, data_num, data_exp, sizev, folder, name, path_data, path_keys, materialfile, nworkers, vnum, cache);
+    }, central_sensi_identification);
+}
     
 } //namespace simcoon
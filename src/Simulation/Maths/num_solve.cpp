@@ -481,4 +481,35 @@ mat denom_FB_m(const vec &Phi, const mat &denom, const vec &Dp)
     return denomFB;
 }
     
+vec Anderson_mixing(const vec &x, const vec &g, mat &dG, mat &dF, vec &g_prev, vec &f_prev, const unsigned int &depth)
+{
+    vec f = g - x;
+    vec x_new = g;
+    
+    if ((depth > 0)&&(g_prev.n_elem == g.n_elem)) {
+        
+        dG = join_rows(dG, g - g_prev);
+        dF = join_rows(dF, f - f_prev);
+        while (dF.n_cols > depth) {
+            dG.shed_col(0);
+            dF.shed_col(0);
+        }
+        
+        //gamma minimizes ||f - dF*gamma||
+        vec gamma;
+        bool status = solve(gamma, dF, f);
+        if ((status)&&(gamma.is_finite())) {
+            x_new = g - dG*gamma;
+        }
+        else {
+            dG.reset();
+            dF.reset();
+        }
+    }
+    
+    g_prev = g;
+    f_prev = f;
+    return x_new;
+}
+    
 } //namespace simcoon
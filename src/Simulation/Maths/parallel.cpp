@@ -0,0 +1,176 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file parallel.cpp
+///@brief Thread pool utilized to distribute independent evaluations (phases, individuals...)
+///@version 1.0
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <simcoon/Simulation/Maths/parallel.hpp>
+
+using namespace std;
+
+namespace simcoon{
+
+//true if the current thread is running a job of a thread pool: nested loops are then run sequentially
+static thread_local bool in_parallel_job = false;
+
+//=====Private methods for thread_pool===================================
+
+//-------------------------------------------------------------
+void thread_pool::work()
+//-------------------------------------------------------------
+{
+    unsigned long seen = 0;
+    while (true) {
+        unique_lock<mutex> lock(mtx);
+        cv_work.wait(lock, [&]{ return (stop || (generation != seen)); });
+        if (stop)
+            return;
+        seen = generation;
+        lock.unlock();
+        
+        run_job();
+        
+        lock.lock();
+        active--;
+        if (active == 0)
+            cv_done.notify_all();
+    }
+}
+
+//-------------------------------------------------------------
+void thread_pool::run_job()
+//-------------------------------------------------------------
+{
+    in_parallel_job = true;
+    for (unsigned int i = job_next++; i < job_size; i = job_next++) {
+        try {
+            (*job)(i);
+        }
+        catch (...) {
+            lock_guard<mutex> lock(mtx);
+            if (!error)
+                error = current_exception();
+        }
+    }
+    in_parallel_job = false;
+}
+
+//=====Public methods for thread_pool====================================
+
+/*!
+  \brief Constructor with the number of threads. 0 uses the hardware concurrency. The calling thread takes part in the loops, so nthreads-1 workers are created
+*/
+    
+//-------------------------------------------------------------
+thread_pool::thread_pool(const unsigned int &nthreads) : job(nullptr), job_size(0), job_next(0), active(0), generation(0), stop(false)
+//-------------------------------------------------------------
+{
+    unsigned int n = nthreads;
+    if (n == 0)
+        n = std::thread::hardware_concurrency();
+    
+    for (unsigned int i=1; i<n; i++) {
+        workers.emplace_back(&thread_pool::work, this);
+    }
+}
+
+/*!
+  \brief Destructor: waits for the workers to terminate
+*/
+
+//-------------------------------------------------------------
+thread_pool::~thread_pool()
+//-------------------------------------------------------------
+{
+    {
+        lock_guard<mutex> lock(mtx);
+        stop = true;
+    }
+    cv_work.notify_all();
+    for (auto &w : workers) {
+        w.join();
+    }
+}
+
+//-------------------------------------------------------------
+unsigned int thread_pool::size() const
+//-------------------------------------------------------------
+{
+    return workers.size() + 1;
+}
+
+//-------------------------------------------------------------
+void thread_pool::parallel_for(const unsigned int &n, const std::function<void(const unsigned int &)> &f)
+//-------------------------------------------------------------
+{
+    if ((workers.empty())||(in_parallel_job)||(n < 2)) {
+        for (unsigned int i=0; i<n; i++) {
+            f(i);
+        }
+        return;
+    }
+    
+    //Only one loop at a time is distributed over the workers
+    lock_guard<mutex> run_lock(run_mtx);
+    {
+        lock_guard<mutex> lock(mtx);
+        job = &f;
+        job_size = n;
+        job_next = 0;
+        active = workers.size();
+        error = nullptr;
+        generation++;
+    }
+    cv_work.notify_all();
+    
+    run_job();
+    
+    exception_ptr job_error;
+    {
+        unique_lock<mutex> lock(mtx);
+        cv_done.wait(lock, [&]{ return (active == 0); });
+        job = nullptr;
+        job_error = error;
+        error = nullptr;
+    }
+    if (job_error)
+        rethrow_exception(job_error);
+}
+
+//-------------------------------------------------------------
+thread_pool& default_thread_pool()
+//-------------------------------------------------------------
+{
+    static thread_pool pool;
+    return pool;
+}
+
+//-------------------------------------------------------------
+void parallel_for(const unsigned int &n, const std::function<void(const unsigned int &)> &f)
+//-------------------------------------------------------------
+{
+    default_thread_pool().parallel_for(n, f);
+}
+
+} //namespace simcoon
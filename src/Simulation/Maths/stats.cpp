@@ -141,4 +141,64 @@ double Pearson7(const double& X, const double& mean, const double &inv_width, ve
 	return max * pow(1. + pow(inv_width*(X - mean), 2.)/shape, -1.*shape);
 }
 
+vec ODF_sd(const vec &Theta, const double &mean, const vec &params) {
+    
+    double alpha1 = params(0);
+    double alpha2 = params(1);
+    double pow1 = params(2);
+    double pow2 = params(3);
+    
+    vec c = cos(Theta - mean);
+    vec s = sin(Theta - mean);
+    vec y = abs((alpha1*pow(c,2.*pow1) + alpha2*pow(c,2.*pow2)%pow(s,2.*pow2))%c);
+    
+    y.elem(find(abs((Theta - mean)-0.5*sim_pi) < 1.E-6)).zeros();
+    y.elem(find(abs(Theta - mean) < 1.E-6)).fill(alpha1);
+    return y;
+}
+
+vec ODF_hard(const vec &Theta, const double &mean, const double &std_dev, const double &ampl) {
+    
+    assert(ampl>0);
+    assert(std_dev>0);
+    
+    return ampl*exp(-0.5*square((Theta - mean)/std_dev));
+}
+
+vec Gaussian(const vec &X, const double &mean, const double &std_dev, const double &ampl){
+    
+    assert(std_dev>0);
+    
+    return ampl/(std_dev * sqrt(2.*sim_pi)) * exp(-1./2. * square((X - mean)/std_dev));
+}
+
+vec Lorentzian(const vec &X, const double &mean, const double &width, const double &ampl){
+    
+    assert(width>0);
+    
+    return (ampl * width/(2.*sim_pi)) / (square(X - mean) + pow(width / 2., 2.));
+}
+
+vec PseudoVoigt(const vec &X, const double &mean, const double &std_dev, const double &width_lor, const double &ampl, const vec &params){
+    
+    double eta = params(0);
+    
+    assert(width_lor>0);
+    assert(std_dev>0);
+    
+    return eta * Lorentzian(X, mean, width_lor, ampl) + (1.-eta) * Gaussian(X, mean, std_dev, ampl);
+}
+
+vec Pearson7(const vec &X, const double &mean, const double &inv_width, const vec &params){
+    
+    double max = params(0);
+    double shape = params(1);
+    assert(shape>0);
+    if (fabs(max) < sim_limit) {
+        max = 1.;
+    }
+    
+    return max * pow(1. + square(inv_width*(X - mean))/shape, -1.*shape);
+}
+
 } //namespace simcoon
@@ -37,6 +37,7 @@
 #include <simcoon/Continuum_mechanics/Homogenization/layer_multi.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/ellipsoid_multi.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/cylinder_multi.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/voxel_multi.hpp>
 #include <simcoon/Simulation/Phase/material_characteristics.hpp>
 #include <simcoon/Simulation/Phase/state_variables.hpp>
 #include <simcoon/Simulation/Phase/state_variables_M.hpp>
@@ -62,6 +63,7 @@ phase_characteristics::phase_characteristics()
     shape_type = 0;
     sv_type = 0;
     sptr_matprops = std::make_shared<material_characteristics>();
+    texture_read = false;
     
     //Note : the construction of sptr_shape = std::make_shared.. and sptr_sv = std::make_shared.. is made in construct(int, int)
    
@@ -86,6 +88,9 @@ phase_characteristics::phase_characteristics(const int &mshape_type, const int &
     sptr_out_global = msptr_out_global;
     sptr_out_local = msptr_out_local;
     sub_phases_file = msub_phases_file;
+    texture_read = false;
+    
+    set_typed_views();
 }
 
 /*!
@@ -107,9 +112,48 @@ phase_characteristics::phase_characteristics(const phase_characteristics& pc)
     sptr_out_global = pc.sptr_out_global;
     sptr_out_local = pc.sptr_out_local;
     
+    sptr_layer = pc.sptr_layer;
+    sptr_layer_multi = pc.sptr_layer_multi;
+    sptr_ellipsoid = pc.sptr_ellipsoid;
+    sptr_ellipsoid_multi = pc.sptr_ellipsoid_multi;
+    
+    sptr_texture = pc.sptr_texture;
+    texture_read = pc.texture_read;
+    
     sub_phases = pc.sub_phases;
     sub_phases_file = pc.sub_phases_file;
 }
+
+/*!
+  \brief Move constructor
+  \param s phase_characteristics object to move from (the shared_ptrs and the sub_phases are taken over, not copied)
+*/
+    
+//------------------------------------------------------
+phase_characteristics::phase_characteristics(phase_characteristics&& pc) noexcept
+//------------------------------------------------------
+{
+    shape_type = pc.shape_type;
+    sv_type = pc.sv_type;
+    sptr_shape = std::move(pc.sptr_shape);
+    sptr_multi = std::move(pc.sptr_multi);
+    sptr_matprops = std::move(pc.sptr_matprops);
+    sptr_sv_global = std::move(pc.sptr_sv_global);
+    sptr_sv_local = std::move(pc.sptr_sv_local);
+    sptr_out_global = std::move(pc.sptr_out_global);
+    sptr_out_local = std::move(pc.sptr_out_local);
+    
+    sptr_layer = std::move(pc.sptr_layer);
+    sptr_layer_multi = std::move(pc.sptr_layer_multi);
+    sptr_ellipsoid = std::move(pc.sptr_ellipsoid);
+    sptr_ellipsoid_multi = std::move(pc.sptr_ellipsoid_multi);
+    
+    sptr_texture = std::move(pc.sptr_texture);
+    texture_read = pc.texture_read;
+    
+    sub_phases = std::move(pc.sub_phases);
+    sub_phases_file = std::move(pc.sub_phases_file);
+}
     
 
 /*!
@@ -163,6 +207,7 @@ void phase_characteristics::construct(const int &mshape_type, const int &msv_typ
             break;
         }
     }
+    set_typed_views();
     
     //Switch case for the state_variables type of the phase
     switch (sv_type) {
@@ -232,7 +277,7 @@ void phase_characteristics::to_start()
         }
     }
     sptr_multi->to_start();
-    for(auto r : sub_phases) {
+    for(auto &r : sub_phases) {
         r.to_start();
     }
     
@@ -263,8 +308,8 @@ void phase_characteristics::set_start(const int &corate_type)
             break;
         }
     }
-    sptr_multi->set_start();
-    for(auto r : sub_phases) {
+    sptr_multi->set_start(corate_type);
+    for(auto &r : sub_phases) {
         r.set_start(corate_type);
     }
 }
@@ -335,12 +380,48 @@ phase_characteristics& phase_characteristics::operator = (const phase_characteri
     sptr_out_global = pc.sptr_out_global;
     sptr_out_local = pc.sptr_out_local;
     
+    sptr_layer = pc.sptr_layer;
+    sptr_layer_multi = pc.sptr_layer_multi;
+    sptr_ellipsoid = pc.sptr_ellipsoid;
+    sptr_ellipsoid_multi = pc.sptr_ellipsoid_multi;
+    
+    sptr_texture = pc.sptr_texture;
+    texture_read = pc.texture_read;
+    
     sub_phases = pc.sub_phases;
     sub_phases_file = pc.sub_phases_file;
     
     return *this;
 }
 
+//----------------------------------------------------------------------
+phase_characteristics& phase_characteristics::operator = (phase_characteristics&& pc) noexcept
+//----------------------------------------------------------------------
+{
+    shape_type = pc.shape_type;
+    sv_type = pc.sv_type;
+    sptr_shape = std::move(pc.sptr_shape);
+    sptr_multi = std::move(pc.sptr_multi);
+    sptr_matprops = std::move(pc.sptr_matprops);
+    sptr_sv_global = std::move(pc.sptr_sv_global);
+    sptr_sv_local = std::move(pc.sptr_sv_local);
+    sptr_out_global = std::move(pc.sptr_out_global);
+    sptr_out_local = std::move(pc.sptr_out_local);
+    
+    sptr_layer = std::move(pc.sptr_layer);
+    sptr_layer_multi = std::move(pc.sptr_layer_multi);
+    sptr_ellipsoid = std::move(pc.sptr_ellipsoid);
+    sptr_ellipsoid_multi = std::move(pc.sptr_ellipsoid_multi);
+    
+    sptr_texture = std::move(pc.sptr_texture);
+    texture_read = pc.texture_read;
+    
+    sub_phases = std::move(pc.sub_phases);
+    sub_phases_file = std::move(pc.sub_phases_file);
+    
+    return *this;
+}
+
 //----------------------------------------------------------------------
 void phase_characteristics::define_output(const std::string &path, const std::string &outputfile, const std::string &coordsys)
 //----------------------------------------------------------------------
@@ -368,6 +449,24 @@ void phase_characteristics::define_output(const std::string &path, const std::st
     
 }
     
+//----------------------------------------------------------------------
+void phase_characteristics::define_output_stream(const std::shared_ptr<std::ostream> &sptr_out, const std::string &coordsys)
+//----------------------------------------------------------------------
+{
+    if(coordsys == "global") {
+        sptr_out_global = sptr_out;
+    }
+    else if(coordsys == "local") {
+        sptr_out_local = sptr_out;
+    }
+    
+    //The sub-phases write in a stream without buffer, that discards their results
+    std::shared_ptr<std::ostream> sptr_null = make_shared<std::ostream>(nullptr);
+    for(auto &r : sub_phases) {
+        r.define_output_stream(sptr_null, coordsys);
+    }
+}
+    
 //----------------------------------------------------------------------
 void phase_characteristics::output(const solver_output &so, const int &kblock, const int &kcycle, const int&kstep, const int &kinc, const double & Time, const std::string &coordsys)
 //----------------------------------------------------------------------
@@ -601,7 +700,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
         }
         *sptr_out_global << endl;
         
-        for(auto r : sub_phases) {
+        for(auto &r : sub_phases) {
             r.output(so, kblock, kcycle, kstep, kinc, Time, "global");
         }
     }
@@ -794,7 +893,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
         }
         *sptr_out_local << endl;
         
-        for(auto r : sub_phases) {
+        for(auto &r : sub_phases) {
             r.output(so, kblock, kcycle, kstep, kinc, Time, "local");
         }
         
@@ -819,7 +918,7 @@ ostream& operator << (ostream& s, const phase_characteristics& pc)
     s << "Display local state variables:\n";
     s << *pc.sptr_sv_local;
     
-    for(auto r : pc.sub_phases) {
+    for(auto &r : pc.sub_phases) {
         s << r;
     }
     
@@ -828,6 +927,17 @@ ostream& operator << (ostream& s, const phase_characteristics& pc)
 	return s;
 }
     
+//----------------------------------------------------------------------
+void phase_characteristics::set_typed_views()
+//----------------------------------------------------------------------
+{
+    //The schemes use these views at every iteration, so that the casts are done once per phase and not once per sweep
+    sptr_layer = std::dynamic_pointer_cast<layer>(sptr_shape);
+    sptr_layer_multi = std::dynamic_pointer_cast<layer_multi>(sptr_multi);
+    sptr_ellipsoid = std::dynamic_pointer_cast<ellipsoid>(sptr_shape);
+    sptr_ellipsoid_multi = std::dynamic_pointer_cast<ellipsoid_multi>(sptr_multi);
+}
+    
 //----------------------------------------------------------------------
 void phase_characteristics::copy(const phase_characteristics& pc)
 //----------------------------------------------------------------------
@@ -839,8 +949,13 @@ void phase_characteristics::copy(const phase_characteristics& pc)
     //Switch case for the geometry of the phase
     switch (shape_type) {
         case 0: {
+            //The phases of a voxel grid are copied with the fields of their voxels
             sptr_shape = std::make_shared<geometry>(*pc.sptr_shape);
-            sptr_multi = std::make_shared<phase_multi>(*pc.sptr_multi);
+            std::shared_ptr<voxel_multi> vox = std::dynamic_pointer_cast<voxel_multi>(pc.sptr_multi);
+            if (vox)
+                sptr_multi = std::make_shared<voxel_multi>(*vox);
+            else
+                sptr_multi = std::make_shared<phase_multi>(*pc.sptr_multi);
             break;
         }
         case 1: {
@@ -870,6 +985,7 @@ void phase_characteristics::copy(const phase_characteristics& pc)
             break;
         }
     }
+    set_typed_views();
     
     //Switch case for the state_variables type of the phase
     switch (sv_type) {
@@ -900,12 +1016,14 @@ void phase_characteristics::copy(const phase_characteristics& pc)
     }
 
     sub_phases.clear();
-    for (unsigned int i=0; i<pc.sub_phases.size(); i++) {
-        phase_characteristics temp;
-        temp.copy(pc.sub_phases[i]);
-        sub_phases.push_back(temp);
+    sub_phases.reserve(pc.sub_phases.size());
+    for (const auto &r : pc.sub_phases) {
+        sub_phases.emplace_back();
+        sub_phases.back().copy(r);
     }
     sub_phases_file = pc.sub_phases_file;
+    sptr_texture = pc.sptr_texture;
+    texture_read = pc.texture_read;
 }
 
 } //namespace simcoon
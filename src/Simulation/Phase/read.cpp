@@ -31,8 +31,10 @@
 #include <simcoon/Simulation/Geometry/cylinder.hpp>
 #include <simcoon/Simulation/Phase/material_characteristics.hpp>
 #include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
 #include <simcoon/Simulation/Phase/read.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/ellipsoid_multi.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/voxel_multi.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
 #include <simcoon/Continuum_mechanics/Functions/natural_basis.hpp>
 
@@ -46,23 +48,17 @@ void get_phase_charateristics(phase_characteristics &rve, const string &path_dat
     string inputfile; //file # that stores the microstructure properties
     
     std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104}};
+    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104},{"MITFA",105},{"MIFFT",106},{"MITAB",107}};
     
     int method = list_umat[rve.sptr_matprops->umat_name];
     
     //first we read the behavior of the phases & we construct the tensors if necessary
     switch (method) {
             
-        case 100: case 101: case 103: {
+        case 100: case 101: case 103: case 105: {
             
             //Definition of the static vectors x,wx,y,wy
-            ellipsoid_multi::mp = rve.sptr_matprops->props(2);
-            ellipsoid_multi::np = rve.sptr_matprops->props(3);
-            ellipsoid_multi::x.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::wx.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::y.set_size(ellipsoid_multi::np);
-            ellipsoid_multi::wy.set_size(ellipsoid_multi::np);
-            points(ellipsoid_multi::x, ellipsoid_multi::wx, ellipsoid_multi::y, ellipsoid_multi::wy,ellipsoid_multi::mp, ellipsoid_multi::np);
+            ellipsoid_multi::set_quadrature(rve.sptr_matprops->props(2), rve.sptr_matprops->props(3));
             
             inputfile = "Nellipsoids" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
             read_ellipsoid(rve, path_data, inputfile);
@@ -73,6 +69,13 @@ void get_phase_charateristics(phase_characteristics &rve, const string &path_dat
             read_layer(rve, path_data, inputfile);
             break;
         }
+        case 106: {
+            inputfile = "Nphases" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
+            read_phase(rve, path_data, inputfile);
+            inputfile = "Nvoxels" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
+            read_voxels(rve, path_data, inputfile);
+            break;
+        }
     }
     
     for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
@@ -115,7 +118,7 @@ void read_phase(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -132,7 +135,7 @@ void read_phase(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         paramphases >> r.sptr_matprops->number >> r.sptr_matprops->umat_name >> r.sptr_matprops->save >>  r.sptr_shape->concentration >> r.sptr_matprops->psi_mat >> r.sptr_matprops->theta_mat >> r.sptr_matprops->phi_mat >> buffer >> buffer;
         
@@ -184,7 +187,7 @@ void read_layer(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -201,7 +204,7 @@ void read_layer(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         sptr_layer = std::dynamic_pointer_cast<layer>(r.sptr_shape);
         paramphases >> r.sptr_matprops->number >> r.sptr_matprops->umat_name >> r.sptr_matprops->save >>  r.sptr_shape->concentration >> r.sptr_matprops->psi_mat >> r.sptr_matprops->theta_mat >> r.sptr_matprops->phi_mat >> sptr_layer->psi_geom >> sptr_layer->theta_geom >> sptr_layer->phi_geom >> buffer >> buffer;
@@ -258,7 +261,7 @@ void read_ellipsoid(phase_characteristics &rve, const string &path_data, const s
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -275,7 +278,7 @@ void read_ellipsoid(phase_characteristics &rve, const string &path_data, const s
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         sptr_ellipsoid = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
         paramphases >> r.sptr_matprops->number >> sptr_ellipsoid->coatingof >> r.sptr_matprops->umat_name >> r.sptr_matprops->save >>  sptr_ellipsoid->concentration >> r.sptr_matprops->psi_mat >> r.sptr_matprops->theta_mat >> r.sptr_matprops->phi_mat >> sptr_ellipsoid->a1 >> sptr_ellipsoid->a2 >>sptr_ellipsoid->a3 >> sptr_ellipsoid->psi_geom >> sptr_ellipsoid->theta_geom >> sptr_ellipsoid->phi_geom >> buffer >> buffer;
@@ -341,7 +344,7 @@ void read_cylinder(phase_characteristics &rve, const string &path_data, const st
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer  >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -359,7 +362,7 @@ void read_cylinder(phase_characteristics &rve, const string &path_data, const st
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
     std::shared_ptr<material_characteristics> sptr_matprops1;
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         sptr_cylinder = std::dynamic_pointer_cast<cylinder>(r.sptr_shape);
         
@@ -391,4 +394,48 @@ void read_cylinder(phase_characteristics &rve, const string &path_data, const st
 }
 
 
+void read_voxels(phase_characteristics &rve, const string &path_data, const string &inputfile) {
+    
+    //The file gives the size of the grid n1 n2 n3, then the number of the phase of each voxel, in the order i + n1*(j + n2*k)
+    std::string buffer;
+    std::string path_inputfile = path_data + "/" + inputfile;
+    std::ifstream paramvoxels;
+    unsigned int n1 = 0;
+    unsigned int n2 = 0;
+    unsigned int n3 = 0;
+    
+    paramvoxels.open(path_inputfile, ios::in);
+    if(!paramvoxels) {
+        cout << "Error: cannot open the file " << inputfile << " that details the voxel grid in the folder :" << path_data << endl;
+        return;
+    }
+    paramvoxels >> buffer >> buffer >> buffer >> n1 >> n2 >> n3 >> buffer;
+    
+    unsigned int nvoxels = n1*n2*n3;
+    uvec number = zeros<uvec>(nvoxels);
+    for (unsigned int i=0; i<nvoxels; i++) {
+        paramvoxels >> number(i);
+    }
+    paramvoxels.close();
+    
+    //Assert that the file has been filled correctly
+    assert(number.n_elem == nvoxels);
+    assert(number.max() < rve.sub_phases.size());
+    
+    //The voxels of each phase share its material characteristics; their fields (one column per voxel) start from the state variables of the phase
+    for(auto &r : rve.sub_phases) {
+        auto sptr_voxels = std::make_shared<voxel_multi>();
+        
+        sptr_voxels->n1 = n1;
+        sptr_voxels->n2 = n2;
+        sptr_voxels->n3 = n3;
+        sptr_voxels->index = find(number == (unsigned int)(r.sptr_matprops->number));
+        sptr_voxels->fill(*std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global));
+        
+        r.sptr_shape->concentration = double(sptr_voxels->index.n_elem)/double(nvoxels);
+        r.sptr_multi = sptr_voxels;
+        r.set_typed_views();
+    }
+}
+
 } //namespace simcoon
@@ -0,0 +1,134 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file column_buffer.cpp
+///@brief Stream buffer that keeps selected columns of the results written by the solver in memory
+///@version 1.0
+
+#include <iostream>
+#include <string>
+#include <armadillo>
+#include <simcoon/Simulation/Solver/column_buffer.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace simcoon{
+
+//=====Private methods for column_buffer===================================
+
+void column_buffer::end_token()
+{
+    if(token.empty())
+        return;
+    
+    if(nline >= skiplines) {
+        for(unsigned int k=0; k<columns.n_elem; k++) {
+            if(columns(k) == int(ncol)) {
+                row[k] = stod(token);
+            }
+        }
+    }
+    ncol++;
+    empty_line = false;
+    token.clear();
+}
+
+void column_buffer::end_line()
+{
+    end_token();
+    if(!empty_line) {
+        if(nline >= skiplines)
+            values.insert(values.end(), row.begin(), row.end());
+        nline++;
+    }
+    std::fill(row.begin(), row.end(), 0.);
+    ncol = 0;
+    empty_line = true;
+}
+
+//=====Public methods for column_buffer====================================
+
+/*!
+ \brief Constructor
+ \param mcolumns : columns to keep, as selected in files_num.inp
+ \param mskiplines : number of non-empty lines to skip
+ */
+
+//-------------------------------------------------------------
+column_buffer::column_buffer(const Col<int> &mcolumns, const int &mskiplines)
+//-------------------------------------------------------------
+{
+    columns = mcolumns;
+    skiplines = mskiplines;
+    ncol = 0;
+    nline = 0;
+    empty_line = true;
+    row.assign(columns.n_elem, 0.);
+}
+
+/*!
+ \brief destructor
+ */
+
+column_buffer::~column_buffer() {}
+
+//-------------------------------------------------------------
+column_buffer::int_type column_buffer::overflow(int_type c)
+//-------------------------------------------------------------
+{
+    if(traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+    
+    char ch = traits_type::to_char_type(c);
+    if(ch == '\n')
+        end_line();
+    else if((ch == ' ')||(ch == '\t')||(ch == '\r'))
+        end_token();
+    else
+        token += ch;
+    return c;
+}
+
+//-------------------------------------------------------------
+streamsize column_buffer::xsputn(const char *s, streamsize n)
+//-------------------------------------------------------------
+{
+    for(streamsize i=0; i<n; i++)
+        overflow(traits_type::to_int_type(s[i]));
+    return n;
+}
+
+//-------------------------------------------------------------
+mat column_buffer::data()
+//-------------------------------------------------------------
+{
+    //A last line without end of line is kept as well
+    if((!token.empty())||(!empty_line))
+        end_line();
+    
+    unsigned int nrows = size();
+    mat D = zeros(nrows, columns.n_elem);
+    for(unsigned int i=0; i<nrows; i++) {
+        for(unsigned int k=0; k<columns.n_elem; k++) {
+            D(i,k) = values[i*columns.n_elem + k];
+        }
+    }
+    return D;
+}
+
+} //namespace simcoon
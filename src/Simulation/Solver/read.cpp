@@ -167,6 +167,22 @@ void read_matprops(string &umat_name, unsigned int &nprops, vec &props, unsigned
     
 }
 
+void read_matprops(string &umat_name, unsigned int &nprops, vec &props, unsigned int &nstatev, double &psi_rve, double &theta_rve, double &phi_rve, istream &propsmat) {
+    
+    ///Material properties from a material definition already in memory (same layout as "material.dat")
+    string buffer;
+    propsmat >> buffer >> buffer >> umat_name >> buffer >> nprops >> buffer >> nstatev;
+    propsmat >> buffer >> buffer >> psi_rve >> buffer >> theta_rve >> buffer >> phi_rve >> buffer;
+    
+    props = zeros(nprops);
+    for(unsigned int i=0;i<nprops;i++)
+        propsmat >> buffer >> props(i);
+    
+    psi_rve*=(sim_pi/180.);
+    theta_rve*=(sim_pi/180.);
+    phi_rve*=(sim_pi/180.);
+}
+
 void read_output(solver_output &so, const int &nblock, const int &nstatev, const string &path_data, const string &outputfile) {
         
     string buffer;
@@ -343,13 +359,6 @@ void check_path_output(const std::vector<block> &blocks, const solver_output &so
 void read_path(std::vector<block> &blocks, double &T, const string &path_data, const string &pathfile) {
     
 	/// Reading the loading path file, Path.txt
-    string buffer;
-    string pathfile_inc;
-    int conver;
-    char bufferchar;
-    unsigned int nblock;
-    Col<int> Equiv = subdiag2vec();
-    
     std::string path_inputfile = path_data + "/" + pathfile;
     std::ifstream path;
 	path.open(path_inputfile, ios::in);
@@ -357,6 +366,19 @@ void read_path(std::vector<block> &blocks, double &T, const string &path_data, c
 	{
 		cout << "Error: cannot open the file " << pathfile << " in the folder :" << path_data << "\n";
 	}
+    
+    read_path(blocks, T, path, path_data);
+    path.close();
+}
+
+void read_path(std::vector<block> &blocks, double &T, istream &path, const string &path_data) {
+    
+    string buffer;
+    string pathfile_inc;
+    int conver;
+    char bufferchar;
+    unsigned int nblock;
+    Col<int> Equiv = subdiag2vec();
 
 	///temperature is initialized
 	path >> buffer >> T >> buffer >> nblock;
@@ -643,7 +665,6 @@ void read_path(std::vector<block> &blocks, double &T, const string &path_data, c
             
         }
     }
-    path.close();
     
 }
 
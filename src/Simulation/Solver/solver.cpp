@@ -53,6 +53,17 @@ namespace simcoon{
 
 void solver(const string &umat_name, const vec &props, const unsigned int &nstatev, const double &psi_rve, const double &theta_rve, const double &phi_rve, const int &solver_type, const int &corate_type, const double &div_tnew_dt_solver, const double &mul_tnew_dt_solver, const int &miniter_solver, const int &maxiter_solver, const int &inforce_solver, const double &precision_solver, const double &lambda_solver, const std::string &path_data, const std::string &path_results, const std::string &pathfile, const std::string &outputfile) {
 
+    std::vector<block> blocks;  //loading blocks
+    double T_init = 0.;
+    
+    //Read the loading path
+    read_path(blocks, T_init, path_data, pathfile);
+    
+    solver(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, solver_type, corate_type, div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, blocks, T_init, path_data, path_results, outputfile);
+}
+    
+void solver(const string &umat_name, const vec &props, const unsigned int &nstatev, const double &psi_rve, const double &theta_rve, const double &phi_rve, const int &solver_type, const int &corate_type, const double &div_tnew_dt_solver, const double &mul_tnew_dt_solver, const int &miniter_solver, const int &maxiter_solver, const int &inforce_solver, const double &precision_solver, const double &lambda_solver, std::vector<block> &blocks, const double &T_init, const std::string &path_data, const std::string &path_results, const std::string &outputfile, const std::shared_ptr<std::ostream> &sptr_out) {
+
     //Check if the required directories exist:
     if(!boost::filesystem::is_directory(path_data)) {
         cout << "error: the folder for the data, " << path_data << ", is not present" << endl;
@@ -74,14 +85,12 @@ void solver(const string &umat_name, const vec &props, const unsigned int &nstat
 	///Usefull UMAT variables
 	int ndi = 3;
 	int nshr = 3;    
-    std::vector<block> blocks;  //loading blocks
     phase_characteristics rve;  // Representative volume element
     
     unsigned int size_meca = 0; //6 for small perturbation, 9 for finite deformation
 	bool start = true;
 	double Time = 0.;
 	double DTime = 0.;
-    double T_init = 0.;
     double tnew_dt = 1.;
     
     mat C = zeros(6,6); //Stiffness dS/dE
@@ -94,10 +103,6 @@ void solver(const string &umat_name, const vec &props, const unsigned int &nstat
     mat dQdE = zeros(6,1);
     mat dQdT = zeros(1,1);
     
-    //read the material properties
-    //Read the loading path
-    read_path(blocks, T_init, path_data, pathfile);
-    
     ///Material properties reading, use "material.dat" to specify parameters values
     rve.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, props.n_elem, props);
     
@@ -190,8 +195,15 @@ void solver(const string &umat_name, const vec &props, const unsigned int &nstat
                 
                 if(start) {
                     //Use the number of phases saved to define the files
-                    rve.define_output(path_results, outputfile_global, "global");
-                    rve.define_output(path_results, outputfile_local, "local");
+                    if(sptr_out) {
+                        //The global results are written in the stream provided, the local ones are not kept
+                        rve.define_output_stream(sptr_out, "global");
+                        rve.define_output_stream(make_shared<std::ostream>(nullptr), "local");
+                    }
+                    else {
+                        rve.define_output(path_results, outputfile_global, "global");
+                        rve.define_output(path_results, outputfile_local, "local");
+                    }
                     //Write the initial results
 //                    rve.output(so, -1, -1, -1, -1, Time, "global");
 //                    rve.output(so, -1, -1, -1, -1, Time, "local");
@@ -734,8 +746,15 @@ void solver(const string &umat_name, const vec &props, const unsigned int &nstat
                 
                 if(start) {
                     //Use the number of phases saved to define the files
-                    rve.define_output(path_results, outputfile_global, "global");
-                    rve.define_output(path_results, outputfile_local, "local");
+                    if(sptr_out) {
+                        //The global results are written in the stream provided, the local ones are not kept
+                        rve.define_output_stream(sptr_out, "global");
+                        rve.define_output_stream(make_shared<std::ostream>(nullptr), "local");
+                    }
+                    else {
+                        rve.define_output(path_results, outputfile_global, "global");
+                        rve.define_output(path_results, outputfile_local, "local");
+                    }
                     //Write the initial results
 //                    rve.output(so, -1, -1, -1, -1, Time, "global");
 //                    rve.output(so, -1, -1, -1, -1, Time, "local");
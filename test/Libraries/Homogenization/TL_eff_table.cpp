@@ -0,0 +1,195 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file TL_eff_table.cpp
+///@brief Test for the tabulated effective stiffness
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "L_eff_table"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <stdexcept>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
+#include <simcoon/Continuum_mechanics/Functions/natural_basis.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/L_eff_table.hpp>
+#include <simcoon/Continuum_mechanics/Umat/umat_L_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Umat/umat_smart.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( L_eff_table_interpolate )
+{
+    //A stiffness that is bilinear in the parameters is reproduced exactly by the interpolation
+    umat parameters = {{1,0},{1,10}};
+    std::vector<vec> axes = {{0.,0.1,0.3}, {1000.,2000.,5000.,10000.}};
+    L_eff_table lt(parameters, axes);
+    
+    auto L_exact = [](const vec &x) -> mat {
+        return (1. + 2.*x(0))*L_iso(x(1), 0.3, "Enu") + x(0)*x(1)*eye(6,6);
+    };
+    
+    BOOST_CHECK( lt.size() == 12 );
+    for (unsigned int n=0; n<lt.size(); n++) {
+        uvec k = lt.node(n);
+        vec x = {axes[0](k(0)), axes[1](k(1))};
+        lt.table.col(n) = vectorise(L_exact(x));
+    }
+    
+    vec x = {0.2, 3000.};
+    BOOST_CHECK( norm(lt.interpolate(x) - L_exact(x),2) < 1.E-9*norm(L_exact(x),2) );
+    x = {0., 10000.};
+    BOOST_CHECK( norm(lt.interpolate(x) - L_exact(x),2) < 1.E-9*norm(L_exact(x),2) );
+    
+    //The points out of the grid are clamped
+    vec x_out = {0.5, 500.};
+    vec x_clamped = {0.3, 1000.};
+    BOOST_CHECK( norm(lt.interpolate(x_out) - L_exact(x_clamped),2) < 1.E-9*norm(L_exact(x_clamped),2) );
+    
+    //Save/load round trip
+    BOOST_CHECK( lt.save("L_eff_table_test.bin") );
+    L_eff_table lt_load;
+    BOOST_CHECK( lt_load.load("L_eff_table_test.bin") );
+    BOOST_CHECK( lt_load.size() == lt.size() );
+    BOOST_CHECK( norm(lt_load.table - lt.table,"fro") < sim_iota );
+    
+    std::shared_ptr<const L_eff_table> lt_shared = L_eff_table::shared("L_eff_table_test.bin");
+    BOOST_CHECK( lt_shared != nullptr );
+    BOOST_CHECK( lt_shared == L_eff_table::shared("L_eff_table_test.bin") );
+    BOOST_CHECK( L_eff_table::shared("missing_table.bin") == nullptr );
+}
+
+BOOST_AUTO_TEST_CASE( L_eff_table_build )
+{
+    //Mori-Tanaka microstructure of data/Nellipsoids0.dat: a matrix (phase 0) and ellipsoids (phase 1)
+    vec props = {2, 0, 20, 20, 0};
+    natural_basis nb;
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    get_L_elastic(rve);
+    
+    //Grid over the volume fraction, the aspect ratio and the Young modulus of the ellipsoids
+    umat parameters = {{1,0},{1,1},{1,10}};
+    std::vector<vec> axes = {{0.1,0.2,0.3}, {1.,3.,5.}, {50000.,70000.}};
+    L_eff_table lt(parameters, axes);
+    lt.build(rve, 4);
+    BOOST_CHECK( lt.table.n_cols == lt.size() );
+    BOOST_CHECK( lt.error.n_elem == 2 );
+    BOOST_CHECK( lt.error(0) >= lt.error(1) );
+    
+    BOOST_CHECK( lt.save("L_eff_table_build.bin") );
+    L_eff_table lt_load;
+    BOOST_CHECK( lt_load.load("L_eff_table_build.bin") );
+    BOOST_CHECK( lt_load.size() == lt.size() );
+    
+    //At the nodes of the grid, the interpolation is the effective stiffness computed directly
+    int mp = 20;
+    int np = 20;
+    vec x = zeros(mp);
+    vec wx = zeros(mp);
+    vec y = zeros(np);
+    vec wy = zeros(np);
+    points(x, wx, y, wy, mp, np);
+    mat xi;
+    vec w;
+    directions(xi, w, x, wx, y, wy, mp, np);
+    
+    for (unsigned int n=0; n<lt_load.size(); n++) {
+        uvec k = lt_load.node(n);
+        vec p = {axes[0](k(0)), axes[1](k(1)), axes[2](k(2))};
+        
+        vector<mat> L(2);
+        L[0] = L_iso(3000., 0.35, "Enu");
+        L[1] = L_iso(p(2), 0.2, "Enu");
+        vector<ellipsoid> ell(2);
+        ell[0] = ellipsoid(1.-p(0), -1, -1, 1., 1., 1., 0., 0., 0.);
+        ell[1] = ellipsoid(p(0), -1, -1, p(1), 1., 1., 30.*(sim_pi/180.), 0., 0.);
+        mat L_direct = L_eff_Mori_Tanaka(L, ell, 0, xi, w);
+        
+        BOOST_CHECK( norm(lt_load.interpolate(p) - L_direct,2) < 1.E-9*norm(L_direct,2) );
+    }
+    
+    //The stiffness of the variants is the one of the nodes
+    mat points_nodes = {{0.1, 0.3}, {3., 5.}, {70000., 50000.}};
+    std::vector<mat> L_var = L_eff_variants(rve, parameters, points_nodes);
+    BOOST_CHECK( L_var.size() == 2 );
+    for (unsigned int v=0; v<L_var.size(); v++) {
+        BOOST_CHECK( norm(L_var[v] - lt_load.interpolate(points_nodes.col(v)),2) < 1.E-9*norm(L_var[v],2) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( umat_multi_table_energy )
+{
+    //Table of a stiffness bilinear in the parameters, utilized by the material MITAB (data/L_eff_table90.bin)
+    umat parameters = {{1,0},{1,10}};
+    std::vector<vec> axes = {{0.,0.1,0.3}, {1000.,2000.,5000.,10000.}};
+    L_eff_table lt(parameters, axes);
+    for (unsigned int n=0; n<lt.size(); n++) {
+        uvec k = lt.node(n);
+        lt.table.col(n) = vectorise((1. + 2.*axes[0](k(0)))*L_iso(axes[1](k(1)), 0.3, "Enu"));
+    }
+    BOOST_CHECK( lt.save("data/L_eff_table90.bin") );
+    
+    vec props = {90, 0.2, 3000.};
+    natural_basis nb;
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, "MITAB", 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    auto sv = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_global);
+    mat L = 1.4*L_iso(3000., 0.3, "Enu");
+    
+    //Two increments of loading then one of unloading: the work is the stored elastic energy, nothing is dissipated
+    mat DR = eye(3,3);
+    bool start = true;
+    double tnew_dt = 1.;
+    std::vector<vec> DE = {{1.E-3, -2.E-4, -3.E-4, 5.E-4, 0., 2.E-4}, {1.E-3, 0., 0., 0., 1.E-4, 0.}, {-1.5E-3, 1.E-4, 2.E-4, -3.E-4, 0., 0.}};
+    for (unsigned int n=0; n<DE.size(); n++) {
+        sv->DEtot = DE[n];
+        select_umat_M(rve, DR, double(n), 1., 3, 3, start, 0, tnew_dt);
+        
+        vec E = sv->Etot + sv->DEtot;
+        double W_el = 0.5*sum((L*E)%E);
+        BOOST_CHECK( norm(sv->sigma - L*E,2) < 1.E-9*norm(L*E,2) );
+        BOOST_CHECK( fabs(sv->Wm(1) - W_el) < 1.E-9*W_el );
+        BOOST_CHECK( fabs(sv->Wm(0) - sv->Wm(1) - sv->Wm(3)) < 1.E-12*W_el );
+        BOOST_CHECK( fabs(sv->Wm(3)) < 1.E-9*W_el );
+        
+        rve.set_start(0);
+        start = false;
+    }
+    
+    //A table that cannot be read is reported as an exception
+    vec props_missing = {91, 0.2, 3000.};
+    phase_characteristics rve_missing;
+    rve_missing.construct(0,1);
+    rve_missing.sptr_matprops->update(0, "MITAB", 1, 0., 0., 0., props_missing.n_elem, props_missing);
+    rve_missing.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    start = true;
+    BOOST_CHECK_THROW( select_umat_M(rve_missing, DR, 0., 1., 3, 3, start, 0, tnew_dt), std::runtime_error );
+}
@@ -25,6 +25,7 @@
 
 #include <armadillo>
 #include <simcoon/parameter.hpp>
+#include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
 #include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
 
 using namespace std;
@@ -90,3 +91,146 @@ BOOST_AUTO_TEST_CASE( S_TII )
     BOOST_CHECK( norm(T_II_num*Lt-S_anal,2) < 1.E-4 );
     
 }
+
+BOOST_AUTO_TEST_CASE( S_analytical )
+{
+    
+    int mp = 300;
+    int np = 300;
+    
+    double E = 70000.;
+    double nu = 0.3;
+    
+    mat Lt = L_iso(E, nu, "Enu");
+    
+    vec x = zeros(mp);
+    vec wx = zeros(mp);
+    vec y = zeros(np);
+    vec wy = zeros(np);
+    points(x, wx, y, wy, mp, np);
+    
+    mat S_anal = zeros(6,6);
+    mat S_num = zeros(6,6);
+    
+    double nu_check = 0.;
+    BOOST_CHECK( check_isotropic(Lt, nu_check) );
+    BOOST_CHECK( fabs(nu_check - nu) < 1.E-9 );
+    
+    //Sphere
+    BOOST_CHECK( Eshelby_analytical(Lt, 1., 1., 1., S_anal) );
+    S_num = Eshelby(Lt, 1., 1., 1., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-9 );
+    
+    //Prolate, axis 1
+    BOOST_CHECK( Eshelby_analytical(Lt, 5., 1., 1., S_anal) );
+    S_num = Eshelby(Lt, 5., 1., 1., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-5 );
+
+    //Oblate, axis 1
+    BOOST_CHECK( Eshelby_analytical(Lt, 0.2, 1., 1., S_anal) );
+    S_num = Eshelby(Lt, 0.2, 1., 1., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-5 );
+    
+    //Prolate, axis 2 and axis 3
+    BOOST_CHECK( Eshelby_analytical(Lt, 1., 5., 1., S_anal) );
+    S_num = Eshelby(Lt, 1., 5., 1., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-5 );
+    
+    BOOST_CHECK( Eshelby_analytical(Lt, 1., 1., 5., S_anal) );
+    S_num = Eshelby(Lt, 1., 1., 5., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-5 );
+    
+    //The selection and the Hill interaction tensor are consistent with the numerical integration
+    S_num = Eshelby_select(Lt, 5., 1., 1., x, wx, y, wy, mp, np);
+    mat T_II_num = T_II_select(Lt, 5., 1., 1., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(T_II_num*Lt-S_num,2) < 1.E-9 );
+    
+    //No closed-form solution for a general ellipsoid or an anisotropic medium: fallback to the numerical integration
+    BOOST_CHECK( !Eshelby_analytical(Lt, 3., 2., 1., S_anal) );
+    S_num = Eshelby(Lt, 3., 2., 1., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(Eshelby_select(Lt, 3., 2., 1., x, wx, y, wy, mp, np)-S_num,2) < 1.E-12 );
+    
+    mat Lt_ortho = L_ortho(70000., 50000., 30000., 0.3, 0.25, 0.2, 20000., 15000., 10000., "EnuG");
+    BOOST_CHECK( !Eshelby_analytical(Lt_ortho, 5., 1., 1., S_anal) );
+}
+
+BOOST_AUTO_TEST_CASE( S_directions )
+{
+    
+    int mp = 20;
+    int np = 20;
+    
+    vec x = zeros(mp);
+    vec wx = zeros(mp);
+    vec y = zeros(np);
+    vec wy = zeros(np);
+    points(x, wx, y, wy, mp, np);
+    
+    mat xi;
+    vec w;
+    directions(xi, w, x, wx, y, wy, mp, np);
+    BOOST_CHECK( xi.n_cols == (unsigned int)(mp*np) );
+    BOOST_CHECK( fabs(accu(w) - 4.*sim_pi) < 1.E-9 );
+    
+    Mat<int> Id(6,6);
+    Id.zeros();
+    Id(0,0) = 0;
+    Id(0,1) = 3;
+    Id(0,2) = 4;
+    Id(1,0) = 3;
+    Id(1,1) = 1;
+    Id(1,2) = 5;
+    Id(2,0) = 4;
+    Id(2,1) = 5;
+    Id(2,2) = 2;
+    
+    //The tabulated integration gives the same Green operator than the integration point by point, for an anisotropic medium
+    mat Lt_ortho = L_ortho(70000., 50000., 30000., 0.3, 0.25, 0.2, 20000., 15000., 10000., "EnuG");
+    mat G_ref = zeros(6,6);
+    Gauss(Id, Lt_ortho, G_ref, 3., 2., 1., x, wx, y, wy, mp, np);
+    mat G = Gauss(Lt_ortho, 3., 2., 1., xi, w);
+    BOOST_CHECK( norm(G-G_ref,2) < 1.E-9*norm(G_ref,2) );
+    
+    mat S_num = Eshelby(Lt_ortho, 3., 2., 1., x, wx, y, wy, mp, np);
+    BOOST_CHECK( norm(Eshelby(Lt_ortho, 3., 2., 1., xi, w)-S_num,2) < 1.E-12 );
+    BOOST_CHECK( norm(T_II(Lt_ortho, 3., 2., 1., xi, w)*Lt_ortho-S_num,2) < 1.E-9 );
+}
+
+BOOST_AUTO_TEST_CASE( S_adaptive )
+{
+    
+    mat Lt = L_iso(70000., 0.3, "Enu");
+    mat S_anal = zeros(6,6);
+    
+    //The quadrature is refined from the starting order up to convergence, and the order used is returned
+    int order = 8;
+    mat S_num = Eshelby_adaptive(Lt, 1., 1., 1., order, 1.E-8);
+    BOOST_CHECK( Eshelby_analytical(Lt, 1., 1., 1., S_anal) );
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-6 );
+    int order_sphere = order;
+    BOOST_CHECK( order_sphere >= 16 );
+
+    //An elongated inclusion requires a higher order than a sphere for the same tolerance
+    order = 8;
+    S_num = Eshelby_adaptive(Lt, 20., 1., 1., order, 1.E-8);
+    BOOST_CHECK( Eshelby_analytical(Lt, 20., 1., 1., S_anal) );
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-5 );
+    BOOST_CHECK( order > order_sphere );
+    
+    mat T_II_num = T_II_adaptive(Lt, 20., 1., 1., order, 1.E-8);
+    BOOST_CHECK( norm(T_II_num*Lt-S_num,2) < 1.E-6 );
+    
+    //The maximal order bounds the refinement
+    order = 8;
+    S_num = Eshelby_adaptive(Lt, 20., 1., 1., order, 1.E-14, 32);
+    BOOST_CHECK( order == 32 );
+    
+    //A starting order above the maximal one is brought back, so that two orders are still compared
+    order = 1000;
+    S_num = Eshelby_adaptive(Lt, 20., 1., 1., order, 1.E-14, 32);
+    BOOST_CHECK( order == 32 );
+    order = 1000;
+    S_num = Eshelby_adaptive(Lt, 20., 1., 1., order, 1.E-8);
+    BOOST_CHECK( order == maxorder_eshelby );
+    BOOST_CHECK( norm(S_num-S_anal,2) < 1.E-5 );
+}
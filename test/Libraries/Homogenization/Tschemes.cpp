@@ -0,0 +1,344 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tschemes.cpp
+///@brief Test for the micromechanical schemes of the phases of a material point
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "schemes"
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Continuum_mechanics/Functions/natural_basis.hpp>
+#include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/ellipsoid_multi.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/multiphase.hpp>
+#include <simcoon/Continuum_mechanics/Umat/umat_L_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Umat/umat_smart.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+#include <simcoon/Simulation/Phase/read.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+//Material point of a micromechanical model, whose phases are described in the folder data
+void rve_construct(phase_characteristics &rve, const string &umat_name, const vec &props)
+{
+    natural_basis nb;
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+}
+
+//Ellipsoidal phases of the file data/Nellipsoids0.dat, with their elastic stiffness
+void rve_ellipsoids(phase_characteristics &rve, const string &umat_name, const vec &props)
+{
+    rve_construct(rve, umat_name, props);
+    ellipsoid_multi::set_quadrature(props(2), props(3));
+    read_ellipsoid(rve, "data", "Nellipsoids0.dat");
+    for (auto &r : rve.sub_phases) {
+        get_L_elastic(r);
+    }
+    rve.global2local();
+}
+
+//Effective tangent modulus from the strain concentration tensors of the phases
+mat Lt_eff(const phase_characteristics &rve)
+{
+    mat Lt = zeros(6,6);
+    for (auto &r : rve.sub_phases) {
+        Lt += r.sptr_shape->concentration*(std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global)->Lt*r.sptr_multi->A);
+    }
+    return Lt;
+}
+
+BOOST_AUTO_TEST_CASE( Lt_Self_Consistent_Broyden_fixed_point )
+{
+    vec props = {2, 0, 20, 20, 0, 1};
+    int n_matrix = 0;
+    
+    //Fixed-point self-consistent loop, as in get_L_elastic (MISCN), started from the Mori-Tanaka estimate
+    phase_characteristics rve_fp;
+    rve_ellipsoids(rve_fp, "MISCN", props);
+    auto sv_fp = std::dynamic_pointer_cast<state_variables_M>(rve_fp.sptr_sv_local);
+    Lt_Self_Consistent(rve_fp, n_matrix, true, 1);
+    
+    //nbiter_tol counts the sweeps needed to reach the tolerance of the Broyden solver (precision_micro on the relative residual)
+    mat Lt_n = zeros(6,6);
+    int nbiter = 0;
+    int nbiter_tol = 0;
+    double error = 1.;
+    while ((error > 1.E-9*norm(sv_fp->Lt,2))&&(nbiter <= 1000)) {
+        Lt_n = sv_fp->Lt;
+        Lt_Self_Consistent(rve_fp, n_matrix, false, 1);
+        sv_fp->Lt = Lt_eff(rve_fp);
+        error = norm(sv_fp->Lt - Lt_n,2);
+        nbiter++;
+        if ((nbiter_tol == 0)&&(error <= precision_micro*norm(Lt_n,2)))
+            nbiter_tol = nbiter;
+    }
+    BOOST_CHECK( nbiter <= 1000 );
+    BOOST_CHECK( nbiter_tol > 0 );
+    
+    //The Broyden solver gives the same self-consistent tangent modulus, up to its tolerance
+    phase_characteristics rve_br;
+    rve_ellipsoids(rve_br, "MISCN", props);
+    int nbiter_br = Lt_Self_Consistent_Broyden(rve_br, n_matrix, true, 1);
+    mat Lt_br = Lt_eff(rve_br);
+    //Both count the sweeps over the phases after the same Mori-Tanaka start: Broyden needs strictly fewer of them
+    BOOST_CHECK( nbiter_br < nbiter_tol );
+    BOOST_CHECK( norm(Lt_br - sv_fp->Lt,2) < 1.E-4*norm(sv_fp->Lt,2) );
+    
+    //The effective tangent modulus of the last reference medium is the reference medium itself
+    auto sv_br = std::dynamic_pointer_cast<state_variables_M>(rve_br.sptr_sv_local);
+    BOOST_CHECK( norm(Lt_br - sv_br->Lt,2) < 1.E-4*norm(Lt_br,2) );
+    
+    //Started from the solution, the solver converges immediately
+    nbiter_br = Lt_Self_Consistent_Broyden(rve_br, n_matrix, false, 1);
+    BOOST_CHECK( nbiter_br <= 3 );
+    BOOST_CHECK( norm(Lt_eff(rve_br) - sv_fp->Lt,2) < 1.E-4*norm(sv_fp->Lt,2) );
+}
+
+BOOST_AUTO_TEST_CASE( TFA_Mori_Tanaka_elastic )
+{
+    vec props = {2, 0, 20, 20, 0};
+    int n_matrix = 0;
+    
+    //Mori-Tanaka tangent modulus of the elastic phases
+    phase_characteristics rve_MT;
+    rve_ellipsoids(rve_MT, "MIMTN", props);
+    Lt_Mori_Tanaka(rve_MT, n_matrix);
+    mat Lt_MT = Lt_eff(rve_MT);
+    
+    //The reduced-order model of the same microstructure, for an increment of strain
+    phase_characteristics rve;
+    rve_construct(rve, "MITFA", props);
+    auto sv = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_global);
+    vec DE = {1.E-3, -2.E-4, -3.E-4, 5.E-4, 0., 2.E-4};
+    sv->DEtot = DE;
+    
+    mat DR = eye(3,3);
+    bool start = true;
+    double tnew_dt = 1.;
+    select_umat_M(rve, DR, 0., 1., 3, 3, start, 0, tnew_dt);
+    
+    //With purely elastic phases, there is no inelastic strain: the effective tangent modulus is the Mori-Tanaka one
+    BOOST_CHECK( norm(sv->Lt - Lt_MT,2) < 1.E-9*norm(Lt_MT,2) );
+    BOOST_CHECK( norm(sv->sigma - Lt_MT*DE,2) < 1.E-9*norm(Lt_MT*DE,2) );
+    
+    //A uniform inelastic strain mu, with the same macroscopic strain, is a stress-free homogeneous strain: A_r*mu + sum_s D_in[s]*mu = mu in each phase r
+    for (auto &r : rve.sub_phases) {
+        BOOST_CHECK( r.sptr_multi->D_in.size() == 2 );
+        mat sumD = zeros(6,6);
+        for (auto &D : r.sptr_multi->D_in)
+            sumD += D;
+        BOOST_CHECK( norm(sumD - (eye(6,6) - r.sptr_multi->A),2) < 1.E-9*norm(r.sptr_multi->A,2) );
+    }
+    
+    //The next calls reuse the concentration and influence tensors of the first one
+    start = false;
+    select_umat_M(rve, DR, 1., 1., 3, 3, start, 0, tnew_dt);
+    BOOST_CHECK( norm(sv->Lt - Lt_MT,2) < 1.E-9*norm(Lt_MT,2) );
+}
+
+//Mori-Tanaka material point with an elastic-plastic matrix, whose inclusions are split into nsplit identical phases (file data/Nellipsoids<nfile>.dat)
+//The stress and tangent modulus are given after three increments of strain
+void umat_MT_split(const int &nsplit, const int &nfile, vec &sigma, mat &Lt, std::vector<vec> &sigma_r)
+{
+    ofstream file("data/Nellipsoids" + to_string(nfile) + ".dat");
+    file << "Number\tCoatingof\tumat\tsave\tc\tpsi_mat\ttheta_mat\tphi_mat\ta1\ta2\ta3\tpsi_geom\ttheta_geom\tphi_geom\tnprops\tnstatev\tprops\n";
+    file << "0\t0\tEPICP\t1\t0.7\t0\t0\t0\t1\t1\t1\t0\t0\t0\t6\t8\t3000\t0.35\t0\t20\t500\t0.3\n";
+    for (int i=1; i<=nsplit; i++)
+        file << i << "\t0\tELISO\t1\t" << 0.3/nsplit << "\t0\t0\t0\t5\t1\t1\t30\t0\t0\t3\t1\t70000\t0.2\t0\n";
+    file.close();
+    
+    vec props = {double(nsplit+1), double(nfile), 20, 20, 0};
+    phase_characteristics rve;
+    rve_construct(rve, "MIMTN", props);
+    auto sv = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_global);
+    
+    mat DR = eye(3,3);
+    bool start = true;
+    double tnew_dt = 1.;
+    vec DE = {1.E-2, -4.E-3, -4.E-3, 2.E-3, 0., 1.E-3};
+    for (int n=0; n<3; n++) {
+        sv->DEtot = DE;
+        select_umat_M(rve, DR, n, 1., 3, 3, start, 0, tnew_dt);
+        rve.set_start(0);
+        start = false;
+    }
+    sigma = sv->sigma;
+    Lt = sv->Lt;
+    sigma_r.clear();
+    for (auto &r : rve.sub_phases)
+        sigma_r.push_back(r.sptr_sv_global->sigma);
+}
+
+BOOST_AUTO_TEST_CASE( umat_multi_parallel )
+{
+    //Reference : one inclusion phase, evaluated sequentially
+    vec sigma_ref;
+    mat Lt_ref;
+    std::vector<vec> sigma_r;
+    umat_MT_split(1, 10, sigma_ref, Lt_ref, sigma_r);
+    BOOST_CHECK( sigma_r.size() == 2 );
+    
+    //Below and above nphases_parallel_micro, the phases being evaluated sequentially then on the thread pool
+    std::vector<int> nsplits = {4, nphases_parallel_micro};
+    for (unsigned int k=0; k<nsplits.size(); k++) {
+        vec sigma;
+        mat Lt;
+        umat_MT_split(nsplits[k], 11+k, sigma, Lt, sigma_r);
+        BOOST_CHECK( (int)sigma_r.size() == nsplits[k]+1 );
+        BOOST_CHECK( norm(sigma - sigma_ref,2) < 1.E-4*norm(sigma_ref,2) );
+        BOOST_CHECK( norm(Lt - Lt_ref,2) < 1.E-4*norm(Lt_ref,2) );
+        
+        //The identical inclusions have the same stress
+        for (int i=2; i<=nsplits[k]; i++)
+            BOOST_CHECK( norm(sigma_r[i] - sigma_r[1],2) < 1.E-9*norm(sigma_r[1],2) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( umat_multi_warm_start )
+{
+    vec props = {2, 0, 20, 20, 0};
+    std::vector<vec> DE(4);
+    DE[0] = {1.E-3, -2.E-4, -3.E-4, 5.E-4, 0., 2.E-4};
+    DE[1] = 2.*DE[0];
+    DE[2] = {-5.E-4, 1.E-3, 0., 0., 3.E-4, 0.};
+    DE[3] = -DE[0];
+    
+    //The same increments of strain, from the last increments of the phases (cold) or from the concentration tensors of the last call (warm)
+    std::vector<phase_characteristics> rve(2);
+    std::vector<std::vector<int> > nbiter(2);
+    std::vector<std::vector<vec> > sigma(2);
+    for (int w=0; w<2; w++) {
+        rve_construct(rve[w], "MIMTN", props);
+        auto sv = std::dynamic_pointer_cast<state_variables_M>(rve[w].sptr_sv_global);
+        mat DR = eye(3,3);
+        bool start = true;
+        double tnew_dt = 1.;
+        for (unsigned int n=0; n<DE.size(); n++) {
+            sv->DEtot = DE[n];
+            rve[w].global2local();
+            nbiter[w].push_back(umat_multi(rve[w], DR, n, 1., 3, 3, start, 0, tnew_dt, 101, (w == 1)));
+            rve[w].local2global();
+            sigma[w].push_back(sv->sigma);
+            rve[w].set_start(0);
+            start = false;
+        }
+    }
+    
+    //With elastic phases, the prediction is exact: the first pass of the scheme is accepted, with the same stress
+    int nbiter_cold = 0;
+    int nbiter_warm = 0;
+    for (unsigned int n=1; n<DE.size(); n++) {
+        BOOST_CHECK( nbiter[1][n] == 1 );
+        BOOST_CHECK( nbiter[0][n] >= 2 );
+        BOOST_CHECK( norm(sigma[1][n] - sigma[0][n],2) < 1.E-9*norm(sigma[0][n],2) );
+        nbiter_cold += nbiter[0][n];
+        nbiter_warm += nbiter[1][n];
+    }
+    BOOST_CHECK( nbiter_warm < nbiter_cold );
+    
+    //The concentration tensors of the prediction are kept in the state variables of the phases
+    unsigned int nstatev_multi = 0;
+    size_statev(rve[1], nstatev_multi);
+    vec statev_multi = zeros(nstatev_multi);
+    unsigned int pos = 0;
+    phases_2_statev(statev_multi, pos, rve[1]);
+    
+    phase_characteristics rve_read;
+    rve_ellipsoids(rve_read, "MIMTN", props);
+    pos = 0;
+    statev_2_phases(rve_read, pos, statev_multi);
+    for (unsigned int i=0; i<rve_read.sub_phases.size(); i++) {
+        BOOST_CHECK( norm(rve_read.sub_phases[i].sptr_multi->A - rve[1].sub_phases[i].sptr_multi->A,"fro") < 1.E-12 );
+        BOOST_CHECK( norm(rve_read.sub_phases[i].sptr_multi->DE_corr - rve[1].sub_phases[i].sptr_multi->DE_corr,2) < 1.E-12 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( interaction_tensor_invalidation )
+{
+    ellipsoid_multi::set_quadrature(20, 20);
+    ellipsoid ell(0.3, 0, -1, 5., 1., 1., 0.5, 0., 0.);
+    mat Lt_m = L_iso(3000., 0.35, "Enu");
+    mat Lt = L_iso(70000., 0.2, "Enu");
+    
+    //T is computed once, then reused while nothing changes
+    ellipsoid_multi em;
+    BOOST_CHECK( em.updateT(Lt_m, Lt, ell) );
+    BOOST_CHECK( em.updateT(Lt_m, Lt, ell) == false );
+    
+    //A change of the tangent moduli, the axes, the orientation or the integration settings recomputes T, as a cold computation
+    auto check_cold = [&](const string &change) {
+        BOOST_TEST_MESSAGE( "Change of " + change );
+        BOOST_CHECK( em.updateT(Lt_m, Lt, ell) );
+        ellipsoid_multi em_cold;
+        em_cold.fillT(Lt_m, Lt, ell);
+        BOOST_CHECK( norm(em.T - em_cold.T,"fro") < 1.E-12*norm(em_cold.T,"fro") );
+        BOOST_CHECK( em.updateT(Lt_m, Lt, ell) == false );
+    };
+    Lt = L_iso(50000., 0.25, "Enu");
+    check_cold("tangent modulus of the phase");
+    Lt_m = L_iso(4000., 0.3, "Enu");
+    check_cold("tangent modulus of the matrix");
+    ell.a1 = 3.;
+    check_cold("axes");
+    ell.theta_geom = 0.2;
+    check_cold("orientation");
+    ellipsoid_multi::set_quadrature(30, 30);
+    check_cold("integration points");
+    ellipsoid_multi::analytical = true;
+    check_cold("analytical Eshelby tensors");
+    ellipsoid_multi::analytical = false;
+    check_cold("numerical Eshelby tensors");
+    
+    //The concentration tensors of a scheme follow : they are those of a material point built with the new settings
+    vec props = {2, 0, 20, 20, 0};
+    int n_matrix = 0;
+    phase_characteristics rve;
+    rve_ellipsoids(rve, "MIMTN", props);
+    Lt_Mori_Tanaka(rve, n_matrix);
+    
+    auto modify = [](phase_characteristics &r) {
+        std::dynamic_pointer_cast<state_variables_M>(r.sub_phases[1].sptr_sv_global)->Lt = L_iso(50000., 0.25, "Enu");
+        std::dynamic_pointer_cast<ellipsoid>(r.sub_phases[1].sptr_shape)->a2 = 2.;
+    };
+    modify(rve);
+    ellipsoid_multi::set_quadrature(16, 16);
+    Lt_Mori_Tanaka(rve, n_matrix);
+    
+    phase_characteristics rve_cold;
+    vec props_cold = {2, 0, 16, 16, 0};
+    rve_ellipsoids(rve_cold, "MIMTN", props_cold);
+    modify(rve_cold);
+    Lt_Mori_Tanaka(rve_cold, n_matrix);
+    for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
+        BOOST_CHECK( norm(rve.sub_phases[i].sptr_multi->A - rve_cold.sub_phases[i].sptr_multi->A,"fro") < 1.E-12*norm(rve_cold.sub_phases[i].sptr_multi->A,"fro") );
+    }
+}
@@ -0,0 +1,260 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+///@file Tschemes_elastic.cpp
+///@brief Test for the elastic micromechanical schemes without state variables
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "schemes_elastic"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/eshelby.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/layer_multi.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_elastic.hpp>
+#include <simcoon/Continuum_mechanics/Functions/natural_basis.hpp>
+#include <simcoon/Continuum_mechanics/Umat/umat_L_elastic.hpp>
+#include <simcoon/Simulation/Maths/rotation.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( L_eff_schemes )
+{
+    
+    int mp = 20;
+    int np = 20;
+    vec x = zeros(mp);
+    vec wx = zeros(mp);
+    vec y = zeros(np);
+    vec wy = zeros(np);
+    points(x, wx, y, wy, mp, np);
+    mat xi;
+    vec w;
+    directions(xi, w, x, wx, y, wy, mp, np);
+    
+    double E_m = 3000.;
+    double nu_m = 0.35;
+    double E_i = 70000.;
+    double nu_i = 0.2;
+    double c = 0.3;
+    
+    vector<mat> L(2);
+    L[0] = L_iso(E_m, nu_m, "Enu");
+    L[1] = L_iso(E_i, nu_i, "Enu");
+    vector<ellipsoid> ell(2);
+    ell[0] = ellipsoid(1.-c, -1, -1, 1., 1., 1., 0., 0., 0.);
+    ell[1] = ellipsoid(c, -1, -1, 1., 1., 1., 0., 0., 0.);
+
+    //Identical phases: the effective stiffness is the stiffness of the phases, for all the schemes
+    vector<mat> L_same(2, L[0]);
+    BOOST_CHECK( norm(L_eff_Mori_Tanaka(L_same, ell, 0, xi, w) - L[0],2) < 1.E-9*norm(L[0],2) );
+    BOOST_CHECK( norm(L_eff_Self_Consistent(L_same, ell, 0, xi, w) - L[0],2) < 1.E-9*norm(L[0],2) );
+    
+    //Spherical particles: the Mori-Tanaka bulk modulus is the Hashin-Shtrikman lower bound
+    double K_m = E_m/(3.*(1.-2.*nu_m));
+    double mu_m = E_m/(2.*(1.+nu_m));
+    double K_i = E_i/(3.*(1.-2.*nu_i));
+    double K_HS = K_m + c*(K_i-K_m)/(1.+(1.-c)*(K_i-K_m)/(K_m+4./3.*mu_m));
+    
+    mat L_MT = L_eff_Mori_Tanaka(L, ell, 0, xi, w);
+    double K_MT = (L_MT(0,0) + 2.*L_MT(0,1))/3.;
+    BOOST_CHECK( fabs(K_MT - K_HS) < 1.E-6*K_HS );
+    
+    //The closed-form Eshelby tensors are selected per call: they agree with the numerical integration for spheres, and are not used for a general ellipsoid
+    mat T_num = T_elastic(L[0], L[1], ell[1], xi, w, false);
+    mat T_anal = T_elastic(L[0], L[1], ell[1], xi, w, true);
+    BOOST_CHECK( norm(T_anal - T_num,2) < 1.E-6*norm(T_num,2) );
+    BOOST_CHECK( norm(L_eff_Mori_Tanaka(L, ell, 0, xi, w, true) - L_MT,2) < 1.E-6*norm(L_MT,2) );
+    ellipsoid ell_3 = ellipsoid(c, -1, -1, 3., 2., 1., 0., 0., 0.);
+    BOOST_CHECK( norm(T_elastic(L[0], L[1], ell_3, xi, w, true) - T_elastic(L[0], L[1], ell_3, xi, w, false),2) < 1.E-12*norm(T_num,2) );
+    
+    //The self-consistent estimate is stiffer than the Mori-Tanaka one for stiff particles, and bounded by the Voigt estimate
+    vec conc = {1.-c, c};
+    mat L_SC = L_eff_Self_Consistent(L, ell, 0, xi, w);
+    mat L_V = L_eff_Homogeneous_E(L, conc);
+    BOOST_CHECK( L_SC(0,0) > L_MT(0,0) );
+    BOOST_CHECK( L_SC(0,0) < L_V(0,0) );
+    
+    //Layers of identical phases
+    vector<layer> lay(2);
+    lay[0] = layer(1.-c, -1, 1, 0., 0., 0.);
+    lay[1] = layer(c, 0, -1, 0., 0., 0.);
+    BOOST_CHECK( norm(L_eff_Periodic_Layer(L_same, lay) - L[0],2) < 1.E-9*norm(L[0],2) );
+    
+    //Layers normal to the direction 1: the shear modulus in the 12 plane is the harmonic average
+    mat L_lay = L_eff_Periodic_Layer(L, lay);
+    double mu_i = E_i/(2.*(1.+nu_i));
+    double mu_R = 1./((1.-c)/mu_m + c/mu_i);
+    BOOST_CHECK( fabs(L_lay(3,3) - mu_R) < 1.E-6*mu_R );
+}
+
+BOOST_AUTO_TEST_CASE( L_eff_Periodic_Layer_stack )
+{
+    
+    double E_m = 3000.;
+    double nu_m = 0.35;
+    double E_i = 70000.;
+    double nu_i = 0.2;
+    double c = 0.3;
+    
+    vector<mat> L2(2);
+    L2[0] = L_iso(E_m, nu_m, "Enu");
+    L2[1] = L_iso(E_i, nu_i, "Enu");
+    
+    //Layers normal to the direction 2
+    double psi = 0.5*sim_pi;
+    vector<layer> lay2(2);
+    lay2[0] = layer(1.-c, -1, 1, psi, 0., 0.);
+    lay2[1] = layer(c, 0, -1, psi, 0., 0.);
+    mat L_eff_2 = L_eff_Periodic_Layer(L2, lay2);
+    
+    //The rotated stack is the rotation of the stack normal to the direction 1
+    lay2[0] = layer(1.-c, -1, 1, 0., 0., 0.);
+    lay2[1] = layer(c, 0, -1, 0., 0., 0.);
+    mat L_eff_1 = L_eff_Periodic_Layer(L2, lay2);
+    BOOST_CHECK( norm(L_eff_2 - rotate_l2g_L(L_eff_1, psi, 0., 0.),2) < 1.E-9*norm(L_eff_1,2) );
+    
+    //Only the volume fractions of the phases matter: an alternating stack of up to 1000 layers gives the same effective stiffness
+    for (unsigned int nlayers : {10, 100, 1000}) {
+        vector<mat> L(nlayers);
+        vector<layer> lay(nlayers);
+        for (unsigned int i=0; i<nlayers; i++) {
+            L[i] = L2[i%2];
+            lay[i] = layer(2.*((i%2 == 0) ? 1.-c : c)/double(nlayers), int(i)-1, (i+1 < nlayers) ? int(i)+1 : -1, psi, 0., 0.);
+        }
+        
+        mat L_eff = L_eff_Periodic_Layer(L, lay);
+        BOOST_CHECK( norm(L_eff - L_eff_2,2) < 1.E-9*norm(L_eff_2,2) );
+    }
+    
+    //A change of orientation of a layer invalidates its normal and tangent parts, even if its tangent modulus is unchanged
+    layer_multi lm;
+    layer lay_rot(c, 0, -1, 0., 0., 0.);
+    BOOST_CHECK( lm.updateD(L2[1], lay_rot) );
+    BOOST_CHECK( !lm.updateD(L2[1], lay_rot) );
+    lay_rot.psi_geom = 0.25*sim_pi;
+    lay_rot.theta_geom = 0.1*sim_pi;
+    lm.updateQ(lay_rot);
+    BOOST_CHECK( lm.updateD(L2[1], lay_rot) );
+    layer_multi lm_ref;
+    lm_ref.updateD(L2[1], lay_rot);
+    BOOST_CHECK( norm(lm.Dnn - lm_ref.Dnn,2) < 1.E-9*norm(lm_ref.Dnn,2) );
+    BOOST_CHECK( norm(lm.Dnt - lm_ref.Dnt,2) < 1.E-9*norm(lm_ref.Dnn,2) );
+    
+    //The periodic layer scheme of a material point (MIPLN), for the two layers normal to the direction 2 of data/Nlayers0.dat
+    vec props = {2, 0};
+    natural_basis nb;
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, "MIPLN", 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    get_L_elastic(rve);
+    mat L_rve = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_global)->Lt;
+    BOOST_CHECK( norm(L_rve - L_eff_2,2) < 1.E-9*norm(L_eff_2,2) );
+    
+    //Closed form: the shear modulus in the 12 plane is the harmonic average
+    double mu_m = E_m/(2.*(1.+nu_m));
+    double mu_i = E_i/(2.*(1.+nu_i));
+    double mu_R = 1./((1.-c)/mu_m + c/mu_i);
+    BOOST_CHECK( fabs(L_rve(3,3) - mu_R) < 1.E-6*mu_R );
+}
+
+BOOST_AUTO_TEST_CASE( L_eff_batch_variants )
+{
+    
+    int mp = 20;
+    int np = 20;
+    vec x = zeros(mp);
+    vec wx = zeros(mp);
+    vec y = zeros(np);
+    vec wy = zeros(np);
+    points(x, wx, y, wy, mp, np);
+    mat xi;
+    vec w;
+    directions(xi, w, x, wx, y, wy, mp, np);
+    
+    //Variants of a matrix with transversely isotropic inclusions: volume fraction, aspect ratio and orientation (degrees) of the inclusions, and orientation of their material
+    vec c = {0.3, 0.2, 0.4};
+    vec a1 = {5., 1., 2.};
+    vec psi_geom = {30., 0., 60.};
+    vec psi_mat = {0., 45., 10.};
+    unsigned int nvariants = c.n_elem;
+    
+    vector<vector<mat> > L(nvariants, vector<mat>(2));
+    vector<vector<ellipsoid> > ell(nvariants, vector<ellipsoid>(2));
+    for (unsigned int i=0; i<nvariants; i++) {
+        L[i][0] = L_iso(3000., 0.35, "Enu");
+        L[i][1] = rotate_l2g_L(L_isotrans(70000., 20000., 0.2, 0.3, 10000., 1), psi_mat(i)*(sim_pi/180.), 0., 0.);
+        ell[i][0] = ellipsoid(1.-c(i), -1, -1, 1., 1., 1., 0., 0., 0.);
+        ell[i][1] = ellipsoid(c(i), -1, -1, a1(i), 1., 1., psi_geom(i)*(sim_pi/180.), 0., 0.);
+        
+        //The same variant, as a microstructure file for the material point (data/Nellipsoids<30+i>.dat)
+        ofstream file("data/Nellipsoids" + to_string(30+i) + ".dat");
+        file << "Number\tCoatingof\tumat\tsave\tc\tpsi_mat\ttheta_mat\tphi_mat\ta1\ta2\ta3\tpsi_geom\ttheta_geom\tphi_geom\tnprops\tnstatev\tprops\n";
+        file << "0\t0\tELISO\t1\t" << 1.-c(i) << "\t0\t0\t0\t1\t1\t1\t0\t0\t0\t3\t1\t3000\t0.35\t0\n";
+        file << "1\t0\tELIST\t1\t" << c(i) << "\t" << psi_mat(i) << "\t0\t0\t" << a1(i) << "\t1\t1\t" << psi_geom(i) << "\t0\t0\t6\t1\t1\t70000\t20000\t0.2\t0.3\t10000\n";
+        file.close();
+    }
+    
+    //Each variant of the batch is checked, element by element, against a separate evaluation: the elastic scheme alone, and the material point of the same microstructure (get_L_elastic, as the single mode of L_eff)
+    std::vector<string> umat_names = {"MIHEN", "MIMTN", "MISCN"};
+    std::vector<int> methods = {100, 101, 103};
+    std::vector<double> tolerances = {1.E-9, 1.E-9, 1.E-5};
+    for (unsigned int k=0; k<methods.size(); k++) {
+        vector<mat> L_b = L_eff_batch(L, ell, methods[k], 0, xi, w);
+        BOOST_CHECK( L_b.size() == nvariants );
+        
+        for (unsigned int i=0; i<nvariants; i++) {
+            mat L_s = zeros(6,6);
+            if (methods[k] == 100) {
+                vec conc = {1.-c(i), c(i)};
+                L_s = L_eff_Homogeneous_E(L[i], conc);
+            }
+            else if (methods[k] == 101)
+                L_s = L_eff_Mori_Tanaka(L[i], ell[i], 0, xi, w);
+            else
+                L_s = L_eff_Self_Consistent(L[i], ell[i], 0, xi, w);
+            
+            vec props = {2, double(30+i), double(mp), double(np), 0, 1};
+            natural_basis nb;
+            phase_characteristics rve;
+            rve.construct(0,1);
+            rve.sptr_matprops->update(0, umat_names[k], 1, 0., 0., 0., props.n_elem, props);
+            rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+            get_L_elastic(rve);
+            mat L_rve = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_global)->Lt;
+            
+            for (int m=0; m<6; m++) {
+                for (int n=0; n<6; n++) {
+                    BOOST_CHECK( fabs(L_b[i](m,n) - L_s(m,n)) < 1.E-12*norm(L_s,2) );
+                    BOOST_CHECK( fabs(L_b[i](m,n) - L_rve(m,n)) < tolerances[k]*norm(L_rve,2) );
+                }
+            }
+        }
+    }
+}
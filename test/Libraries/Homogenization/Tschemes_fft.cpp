@@ -0,0 +1,198 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tschemes_fft.cpp
+///@brief Test for the FFT-based full-field homogenization
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "schemes_fft"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <memory>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Continuum_mechanics/Functions/constitutive.hpp>
+#include <simcoon/Continuum_mechanics/Homogenization/voxel_multi.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/schemes_fft.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/state_variables_M.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( fft_3D_inverse )
+{
+    unsigned int n1 = 4;
+    unsigned int n2 = 3;
+    unsigned int n3 = 1;
+    
+    mat f = randu(n1*n2*n3, 6);
+    cx_mat f_hat(f, zeros(n1*n2*n3, 6));
+    
+    fft_3D(f_hat, n1, n2, n3);
+    //The average is the zero frequency
+    BOOST_CHECK( norm(real(f_hat.row(0))/double(n1*n2*n3) - mean(f,0),2) < 1.E-9 );
+    
+    fft_3D(f_hat, n1, n2, n3, true);
+    BOOST_CHECK( norm(real(f_hat) - f,"fro") < 1.E-9 );
+}
+
+BOOST_AUTO_TEST_CASE( Lt_FFT_laminate )
+{
+    //Two isotropic layers of equal thickness, normal to the direction 1, on a 8 x 2 x 2 grid
+    unsigned int n1 = 8;
+    unsigned int n2 = 2;
+    unsigned int n3 = 2;
+    
+    double lambda_1 = 1000.;
+    double mu_1 = 1000.;
+    double lambda_2 = 10000.;
+    double mu_2 = 8000.;
+    
+    vector<mat> L(2);
+    L[0] = L_iso(lambda_1, mu_1, "lambdamu");
+    L[1] = L_iso(lambda_2, mu_2, "lambdamu");
+    
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sub_phases_construct(2,0,1);
+    
+    double lambda_0 = 0.;
+    double mu_0 = 0.;
+    reference_medium_fft(lambda_0, mu_0, L);
+    
+    for (unsigned int p=0; p<2; p++) {
+        auto vox = std::make_shared<voxel_multi>();
+        vox->n1 = n1;
+        vox->n2 = n2;
+        vox->n3 = n3;
+        vox->lambda_0 = lambda_0;
+        vox->mu_0 = mu_0;
+        
+        std::vector<unsigned int> index;
+        for (unsigned int k=0; k<n3; k++) {
+            for (unsigned int j=0; j<n2; j++) {
+                for (unsigned int i=0; i<n1; i++) {
+                    if ((i < n1/2) == (p == 0))
+                        index.push_back(i + n1*(j + n2*k));
+                }
+            }
+        }
+        vox->index = conv_to<uvec>::from(index);
+        
+        auto sv_p = std::dynamic_pointer_cast<state_variables_M>(rve.sub_phases[p].sptr_sv_global);
+        sv_p->Lt = L[p];
+        vox->fill(*sv_p);
+        rve.sub_phases[p].sptr_multi = vox;
+    }
+    
+    //Reuss average normal to the layers, Voigt average in the plane of the layers
+    mat Lt_eff = Lt_FFT(rve, 0);
+    double L11 = 2./(1./(lambda_1 + 2.*mu_1) + 1./(lambda_2 + 2.*mu_2));
+    double G12 = 2./(1./mu_1 + 1./mu_2);
+    double G23 = 0.5*(mu_1 + mu_2);
+    
+    BOOST_CHECK( fabs(Lt_eff(0,0) - L11) < 1.E-4*L11 );
+    BOOST_CHECK( fabs(Lt_eff(3,3) - G12) < 1.E-4*G12 );
+    BOOST_CHECK( fabs(Lt_eff(4,4) - G12) < 1.E-4*G12 );
+    BOOST_CHECK( fabs(Lt_eff(5,5) - G23) < 1.E-4*G23 );
+    BOOST_CHECK( norm(Lt_eff - Lt_eff.t(),"fro") < 1.E-4*norm(Lt_eff,"fro") );
+    
+    //The accelerated scheme gives the same solution
+    mat Lt_eff_acc = Lt_FFT(rve, 1);
+    BOOST_CHECK( norm(Lt_eff_acc - Lt_eff,"fro") < 1.E-4*norm(Lt_eff,"fro") );
+}
+
+BOOST_AUTO_TEST_CASE( voxel_multi_copy )
+{
+    //The assignment copies the localization data of phase_multi with the grid
+    voxel_multi vm;
+    vm.A = 2.*eye(6,6);
+    vm.DE_corr = ones(6);
+    vm.M_in = 3.*eye(6,6);
+    vm.D_in = std::vector<mat>(2, 4.*eye(6,6));
+    vm.n1 = 4;
+    vm.index = {0, 2, 5};
+    vm.sigma = randu(6, 3);
+    vm.statev = randu(2, 3);
+    vm.Lt = randu(36, 3);
+    
+    voxel_multi vm_copy;
+    vm_copy = vm;
+    BOOST_CHECK( norm(vm_copy.A - vm.A,"fro") < 1.E-12 );
+    BOOST_CHECK( norm(vm_copy.DE_corr - vm.DE_corr,2) < 1.E-12 );
+    BOOST_CHECK( norm(vm_copy.M_in - vm.M_in,"fro") < 1.E-12 );
+    BOOST_CHECK( vm_copy.D_in.size() == 2 );
+    BOOST_CHECK( vm_copy.n1 == 4 );
+    BOOST_CHECK( vm_copy.size() == 3 );
+    BOOST_CHECK( norm(vm_copy.sigma - vm.sigma,"fro") < 1.E-12 );
+    BOOST_CHECK( norm(vm_copy.statev - vm.statev,"fro") < 1.E-12 );
+    BOOST_CHECK( norm(vm_copy.Lt - vm.Lt,"fro") < 1.E-12 );
+}
+
+BOOST_AUTO_TEST_CASE( voxel_multi_fields )
+{
+    //The voxels start from the state variables of their phase
+    state_variables_M sv;
+    sv.resize(2);
+    sv.Etot = ones(6);
+    sv.sigma_start = 2.*ones(6);
+    sv.statev_start = {1., 2.};
+    sv.Lt = 3.*eye(6,6);
+    
+    voxel_multi vm;
+    vm.index = {1, 4, 7, 8};
+    vm.fill(sv);
+    BOOST_CHECK( vm.Etot.n_cols == 4 );
+    BOOST_CHECK( vm.Lt.n_rows == 36 );
+    
+    //A voxel is read at the start of the increment, and its state after the constitutive model is stored in its column only
+    state_variables_M sv_v(sv);
+    vm.DEtot.col(2) = 0.1*ones(6);
+    vm.get(2, sv_v);
+    BOOST_CHECK( norm(sv_v.DEtot - 0.1*ones(6),2) < 1.E-12 );
+    BOOST_CHECK( norm(sv_v.sigma - sv.sigma_start,2) < 1.E-12 );
+    BOOST_CHECK( norm(sv_v.statev - sv.statev_start,2) < 1.E-12 );
+    sv_v.sigma = 5.*ones(6);
+    sv_v.statev = {3., 4.};
+    sv_v.Lt = 4.*eye(6,6);
+    vm.set(2, sv_v);
+    BOOST_CHECK( norm(vm.sigma.col(2) - 5.*ones(6),2) < 1.E-12 );
+    BOOST_CHECK( norm(mat(vm.Lt.colptr(2), 6, 6) - 4.*eye(6,6),"fro") < 1.E-12 );
+    BOOST_CHECK( norm(vm.sigma.col(1) - vm.sigma_start.col(1),2) < 1.E-12 );
+    
+    //The new start of the increment is the last state of the voxels, and the strain is accumulated
+    vm.set_start(0);
+    BOOST_CHECK( norm(vm.sigma_start.col(2) - 5.*ones(6),2) < 1.E-12 );
+    BOOST_CHECK( norm(vm.statev_start.col(2) - sv_v.statev,2) < 1.E-12 );
+    BOOST_CHECK( norm(vm.Etot.col(2) - 1.1*ones(6),2) < 1.E-12 );
+    
+    //The copy of a phase of the grid keeps its voxels (no slicing of voxel_multi)
+    phase_characteristics r;
+    r.construct(0,1);
+    r.sptr_multi = std::make_shared<voxel_multi>(vm);
+    phase_characteristics r_copy;
+    r_copy.copy(r);
+    auto vm_copy = std::dynamic_pointer_cast<voxel_multi>(r_copy.sptr_multi);
+    BOOST_CHECK( vm_copy != nullptr );
+    BOOST_CHECK( vm_copy != std::dynamic_pointer_cast<voxel_multi>(r.sptr_multi) );
+    BOOST_CHECK( vm_copy->size() == 4 );
+    BOOST_CHECK( norm(vm_copy->sigma - vm.sigma,"fro") < 1.E-12 );
+}
@@ -0,0 +1,147 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Teval_cache.cpp
+///@brief Test for the cache of the numerical vectors of the identification
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "eval_cache"
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <boost/filesystem.hpp>
+#include <simcoon/Simulation/Identification/parameters.hpp>
+#include <simcoon/Simulation/Identification/constants.hpp>
+#include <simcoon/Simulation/Identification/eval_cache.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+static void write_file(const string &path, const string &text) {
+    ofstream out(path);
+    out << text;
+}
+
+//Two parameters in a key file, a data file without keys
+static vector<parameters> cache_problem(const string &path_keys, const string &path_data, const string &data_text) {
+    boost::filesystem::create_directories(path_keys);
+    boost::filesystem::create_directories(path_data);
+    write_file(path_keys + "/material.dat", "E @1p nu @2p\n");
+    write_file(path_data + "/path.txt", data_text);
+    
+    vector<parameters> params;
+    params.push_back(parameters(0, 0., 10., "@1p", 1, {"material.dat"}));
+    params.push_back(parameters(1, 100., 200., "@2p", 1, {"material.dat"}));
+    return params;
+}
+
+BOOST_AUTO_TEST_CASE( eval_cache_key )
+{
+    vector<parameters> params = cache_problem("cache_keys", "cache_data", "E 0.02\n");
+    eval_cache ec(params, vector<constants>(), "cache_keys", "cache_data", 3, 1.E-6);
+    
+    //The quantization step is 1.E-5 for the first parameter and 1.E-4 for the second one
+    vec p = {1., 150.};
+    vec p_near = {1. + 1.E-7, 150. - 1.E-6};
+    vec p_far = {1. + 1.E-3, 150.};
+    vec p_far2 = {1., 150. + 1.E-3};
+    
+    BOOST_CHECK( ec.key(p) == ec.key(p_near) );
+    BOOST_CHECK( ec.key(p) != ec.key(p_far) );
+    BOOST_CHECK( ec.key(p) != ec.key(p_far2) );
+    BOOST_CHECK( ec.key(p)[0] == 1.E5 );
+    BOOST_CHECK( ec.key(p)[1] == 5.E5 );
+}
+
+BOOST_AUTO_TEST_CASE( eval_cache_find_insert )
+{
+    vector<parameters> params = cache_problem("cache_keys", "cache_data", "E 0.02\n");
+    eval_cache ec(params, vector<constants>(), "cache_keys", "cache_data", 3, 1.E-6);
+    
+    vec p = {1., 150.};
+    vec p_near = {1. + 1.E-7, 150. - 1.E-6};
+    vec p_far = {1. + 1.E-3, 150.};
+    vec vnum = {1., 2., 3.};
+    vec vnum_found;
+    
+    BOOST_CHECK( ec.find(p, vnum_found) == false );
+    ec.insert(p, vnum);
+    BOOST_CHECK( ec.size() == 1 );
+    
+    BOOST_CHECK( ec.find(p_near, vnum_found) );
+    BOOST_CHECK( norm(vnum_found - vnum) == 0. );
+    BOOST_CHECK( ec.find(p_far, vnum_found) == false );
+    BOOST_CHECK( ec.hits == 1 );
+    
+    //A parameter set already in the cache is replaced
+    ec.insert(p_near, 2.*vnum);
+    BOOST_CHECK( ec.size() == 1 );
+    BOOST_CHECK( ec.find(p, vnum_found) );
+    BOOST_CHECK( norm(vnum_found - 2.*vnum) == 0. );
+    BOOST_CHECK( ec.hits == 2 );
+}
+
+BOOST_AUTO_TEST_CASE( eval_cache_save_load )
+{
+    vector<parameters> params = cache_problem("cache_keys", "cache_data", "E 0.02\n");
+    eval_cache ec(params, vector<constants>(), "cache_keys", "cache_data", 3, 1.E-6);
+    
+    vec p = {1., 150.};
+    vec p2 = {2., 120.};
+    vec vnum = {1., 2., 3.};
+    ec.insert(p, vnum);
+    ec.insert(p2, -vnum);
+    BOOST_CHECK( ec.save("cache_test.bin") );
+    
+    //Same problem : the entries are read
+    eval_cache ec_same(params, vector<constants>(), "cache_keys", "cache_data", 3, 1.E-6);
+    BOOST_CHECK( ec_same.signature == ec.signature );
+    BOOST_CHECK( ec_same.load("cache_test.bin") );
+    BOOST_CHECK( ec_same.size() == 2 );
+    vec vnum_found;
+    BOOST_CHECK( ec_same.find(p2, vnum_found) );
+    BOOST_CHECK( norm(vnum_found + vnum) == 0. );
+    
+    //Another data file : the signature differs, the cache is rejected and the current entries are kept
+    cache_problem("cache_keys", "cache_data_other", "E 0.03\n");
+    eval_cache ec_data(params, vector<constants>(), "cache_keys", "cache_data_other", 3, 1.E-6);
+    vec vnum_other = {4., 5., 6.};
+    ec_data.insert(p, vnum_other);
+    BOOST_CHECK( ec_data.signature != ec.signature );
+    BOOST_CHECK( ec_data.load("cache_test.bin") == false );
+    BOOST_CHECK( ec_data.size() == 1 );
+    BOOST_CHECK( ec_data.find(p, vnum_found) );
+    BOOST_CHECK( norm(vnum_found - vnum_other) == 0. );
+    
+    //Another size of the numerical vector or another range of the parameters are rejected as well
+    eval_cache ec_size(params, vector<constants>(), "cache_keys", "cache_data", 4, 1.E-6);
+    BOOST_CHECK( ec_size.load("cache_test.bin") == false );
+    BOOST_CHECK( ec_size.size() == 0 );
+    params[1].max_value = 300.;
+    eval_cache ec_range(params, vector<constants>(), "cache_keys", "cache_data", 3, 1.E-6);
+    BOOST_CHECK( ec_range.load("cache_test.bin") == false );
+    
+    //A file that is not a cache
+    write_file("cache_wrong.bin", "E 0.02\n");
+    BOOST_CHECK( ec_same.load("cache_wrong.bin") == false );
+    BOOST_CHECK( ec_same.load("cache_missing.bin") == false );
+}
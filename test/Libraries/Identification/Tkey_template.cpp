@@ -0,0 +1,82 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tkey_template.cpp
+///@brief Test for the substitution of the parameters in the key files of the identification
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "key_template"
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <simcoon/Simulation/Identification/key_template.hpp>
+
+using namespace std;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( key_template_apply )
+{
+    string text = "Material\nE @1 nu @2\nalpha @10 @1\nend";
+    ofstream out("keys_test.dat");
+    out << text;
+    out.close();
+    
+    //The keys are found in the order of the file; when two keys start at the same position (@1 and @10), the longest one is kept
+    vector<string> keys = {"@1", "@2", "@10"};
+    key_template kt(".", "keys_test.dat", keys);
+    BOOST_CHECK( kt.size() == 4 );
+    BOOST_CHECK( kt.tokens.size() == kt.size() + 1 );
+    BOOST_CHECK( kt.slots[0] == "@1" );
+    BOOST_CHECK( kt.slots[1] == "@2" );
+    BOOST_CHECK( kt.slots[2] == "@10" );
+    BOOST_CHECK( kt.slots[3] == "@1" );
+    
+    map<string, string> values = {{"@1","70000"}, {"@2","0.3"}, {"@10","1.E-5"}};
+    BOOST_CHECK_EQUAL( kt.apply(values), "Material\nE 70000 nu 0.3\nalpha 1.E-5 70000\nend" );
+    
+    //The keys without a value are left in the text
+    map<string, string> values_partial = {{"@2","0.3"}};
+    BOOST_CHECK_EQUAL( kt.apply(values_partial), "Material\nE @1 nu 0.3\nalpha @10 @1\nend" );
+    
+    //Without values, the text of the file is recovered
+    BOOST_CHECK_EQUAL( kt.apply(map<string, string>()), text );
+    
+    //The written file is the substituted text
+    kt.file = "keys_test_out.dat";
+    kt.write(".", values);
+    ifstream in("keys_test_out.dat");
+    stringstream buffer;
+    buffer << in.rdbuf();
+    BOOST_CHECK_EQUAL( buffer.str(), kt.apply(values) );
+    
+    //A file without keys is a single token
+    key_template kt_none(".", "keys_test.dat", {"@3"});
+    BOOST_CHECK( kt_none.size() == 0 );
+    BOOST_CHECK_EQUAL( kt_none.apply(values), text );
+    
+    //The shared template is parsed once for a file and a set of keys
+    std::shared_ptr<const key_template> kt_shared = key_template::shared(".", "keys_test.dat", keys);
+    BOOST_CHECK( kt_shared == key_template::shared(".", "keys_test.dat", keys) );
+    BOOST_CHECK_EQUAL( kt_shared->apply(values), kt.apply(values) );
+    std::shared_ptr<const key_template> kt_other = key_template::shared(".", "keys_test.dat", {"@1"});
+    BOOST_CHECK( kt_other != kt_shared );
+    BOOST_CHECK( kt_other->size() == 3 );
+}
@@ -0,0 +1,272 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tmethods.cpp
+///@brief Test for the differential evolution and the CMA-ES of the identification
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "methods"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <set>
+#include <atomic>
+#include <algorithm>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Identification/parameters.hpp>
+#include <simcoon/Simulation/Identification/generation.hpp>
+#include <simcoon/Simulation/Identification/methods.hpp>
+#include <simcoon/Simulation/Identification/cmaes.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+//Ill-conditioned ellipsoid centered on p_opt
+static double ellipsoid(const vec &p, const vec &p_opt) {
+    double f = 0.;
+    for (unsigned int j=0; j<p.n_elem; j++)
+        f += pow(10., 3.*j/(p.n_elem-1.))*(p(j)-p_opt(j))*(p(j)-p_opt(j));
+    return f;
+}
+
+BOOST_AUTO_TEST_CASE( cmaes_ellipsoid )
+{
+    arma_rng::set_seed(42);
+    int n_param = 5;
+    int lambda = 12;
+    int idnumber = 0;
+    std::vector<parameters> params;
+    for (int j=0; j<n_param; j++)
+        params.push_back(parameters(j, 0., 10.));
+    vec p_opt = {2., 7., 4.5, 1., 8.};
+    
+    cmaes es(params, lambda, 5.*ones(n_param));
+    generation gensons(lambda, n_param, idnumber);
+    
+    double best = datum::inf;
+    for (int g=0; g<300; g++) {
+        es.sample(gensons, idnumber);
+        for (int i=0; i<gensons.size(); i++) {
+            //The sampled individuals stay in the bounds
+            BOOST_CHECK( gensons.pop[i].p.min() >= 0. );
+            BOOST_CHECK( gensons.pop[i].p.max() <= 10. );
+            gensons.pop[i].cout = ellipsoid(gensons.pop[i].p, p_opt);
+            best = std::min(best, gensons.pop[i].cout);
+        }
+        es.update(gensons);
+    }
+    BOOST_CHECK( best < 1.E-8 );
+}
+
+BOOST_AUTO_TEST_CASE( differential_evolution_bounds )
+{
+    srand(42);
+    int n_param = 4;
+    int maxpop = 20;
+    int idnumber = 0;
+    std::vector<parameters> params;
+    for (int j=0; j<n_param; j++)
+        params.push_back(parameters(j, -1., 1.));
+    
+    generation gen_g(maxpop, n_param, idnumber);
+    for (int i=0; i<maxpop; i++)
+        gen_g.pop[i].p = 2.*randu<vec>(n_param) - 1.;
+    generation gensons(maxpop, n_param, idnumber);
+    
+    //Without crossover, a trial individual differs from its target by one parameter only, and stays in the bounds
+    differential_evolution(gen_g, gensons, idnumber, 2., 0., params);
+    for (int i=0; i<maxpop; i++) {
+        BOOST_CHECK( gensons.pop[i].p.min() >= -1. );
+        BOOST_CHECK( gensons.pop[i].p.max() <= 1. );
+        int ndiff = 0;
+        for (int j=0; j<n_param; j++) {
+            if (gensons.pop[i].p(j) != gen_g.pop[i].p(j))
+                ndiff++;
+        }
+        BOOST_CHECK( ndiff <= 1 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( differential_evolution_selection )
+{
+    srand(42);
+    arma_rng::set_seed(42);
+    int n_param = 3;
+    int maxpop = 10;
+    int idnumber = 0;
+    int id0 = 0;
+    
+    generation gen_old(maxpop, n_param, idnumber);
+    generation gensons(maxpop, n_param, idnumber);
+    for (int i=0; i<maxpop; i++) {
+        gen_old.pop[i].cout = i;
+        gensons.pop[i].cout = (i%2 == 0) ? i - 0.5 : i + 0.5;
+    }
+    generation gen_cur;
+    generation gboys_old;
+    generation gboys_cur;
+    
+    //Each trial replaces its own target if it is better, whatever the costs of the other individuals
+    select_trials(gen_cur, gboys_cur, gen_old, gboys_old, gensons, maxpop, n_param, id0);
+    BOOST_CHECK( gen_cur.size() == maxpop );
+    for (int i=0; i<maxpop; i++) {
+        int k = (i%2 == 0) ? i : i-1;
+        if (i%2 == 0)
+            BOOST_CHECK( gen_cur.pop[i].cout == k - 0.5 );
+        else
+            BOOST_CHECK( gen_cur.pop[i].cout == k + 1. );
+    }
+    
+    //The gboys are the targets of the first trials, and the best individuals of the new generation
+    gboys_old.construct(2, n_param, idnumber);
+    gboys_old.pop[0].cout = -2.;
+    gboys_old.pop[1].cout = 10.;
+    select_trials(gen_cur, gboys_cur, gen_old, gboys_old, gensons, maxpop, n_param, id0);
+    BOOST_CHECK( gboys_cur.size() == 2 );
+    BOOST_CHECK( gen_cur.pop[0].cout == -2. );
+    BOOST_CHECK( gboys_cur.pop[0].cout == -2. );
+    BOOST_CHECK( gboys_cur.pop[1].cout == 1.5 );
+}
+
+BOOST_AUTO_TEST_CASE( differential_evolution_ellipsoid )
+{
+    srand(42);
+    arma_rng::set_seed(42);
+    int n_param = 3;
+    int maxpop = 20;
+    int idnumber = 0;
+    int id0 = 0;
+    std::vector<parameters> params;
+    for (int j=0; j<n_param; j++)
+        params.push_back(parameters(j, 0., 10.));
+    vec p_opt = {2., 7., 4.5};
+    
+    generation gen_g(maxpop, n_param, idnumber);
+    for (int i=0; i<maxpop; i++) {
+        gen_g.pop[i].p = 10.*randu<vec>(n_param);
+        gen_g.pop[i].cout = ellipsoid(gen_g.pop[i].p, p_opt);
+    }
+    gen_g.classify();
+    generation gensons(maxpop, n_param, idnumber);
+    generation gboys;
+    generation gen_cur;
+    generation gboys_cur;
+    
+    for (int g=0; g<300; g++) {
+        differential_evolution(gen_g, gensons, idnumber, F_differential_evolution, CR_differential_evolution, params);
+        for (int i=0; i<maxpop; i++)
+            gensons.pop[i].cout = ellipsoid(gensons.pop[i].p, p_opt);
+        
+        double best_old = gen_g.pop[0].cout;
+        select_trials(gen_cur, gboys_cur, gen_g, gboys, gensons, maxpop, n_param, id0);
+        //The best individual is never lost
+        BOOST_CHECK( gen_cur.pop[0].cout <= best_old );
+        gen_g = gen_cur;
+    }
+    BOOST_CHECK( gen_g.pop[0].cout < 1.E-8 );
+    BOOST_CHECK( norm(gen_g.pop[0].p - p_opt) < 1.E-3 );
+}
+
+BOOST_AUTO_TEST_CASE( steady_state_ellipsoid )
+{
+    srand(42);
+    arma_rng::set_seed(42);
+    int n_param = 2;
+    int maxpop = 10;
+    int nsons = 60;
+    int idnumber = 0;
+    std::vector<parameters> params;
+    for (int j=0; j<n_param; j++)
+        params.push_back(parameters(j, 0., 10.));
+    vec p_opt = {2., 7.};
+    
+    generation pop(maxpop, n_param, idnumber);
+    for (int i=0; i<maxpop; i++) {
+        pop.pop[i].p = 10.*randu<vec>(n_param);
+        pop.pop[i].cout = ellipsoid(pop.pop[i].p, p_opt);
+    }
+    pop.classify();
+    generation pop_init = pop;
+    generation gensons(nsons, n_param, idnumber);
+    int id_start = idnumber;
+    
+    //With one worker, the population is updated before each evaluation : the best cost never increases, and one evaluation fails
+    int ncalls = 0;
+    std::vector<double> best;
+    auto cost = [&](const individual &son, const unsigned int &k) {
+        BOOST_CHECK( k == 0 );
+        best.push_back(pop.pop[0].cout);
+        ncalls++;
+        return (ncalls == 3) ? datum::nan : ellipsoid(son.p, p_opt);
+    };
+    steady_state(pop, gensons, idnumber, 5., 0.1, params, 1, cost);
+    
+    //One evaluation per son, with a new id
+    BOOST_CHECK( ncalls == nsons );
+    BOOST_CHECK( idnumber == id_start + nsons );
+    for (int i=0; i<nsons; i++) {
+        BOOST_CHECK( gensons.pop[i].id == id_start + i );
+        if (i != 2)
+            BOOST_CHECK( fabs(gensons.pop[i].cout - ellipsoid(gensons.pop[i].p, p_opt)) < 1.E-12 );
+    }
+    BOOST_CHECK( std::isnan(gensons.pop[2].cout) );
+    best.push_back(pop.pop[0].cout);
+    for (unsigned int i=1; i<best.size(); i++)
+        BOOST_CHECK( best[i] <= best[i-1] );
+    
+    //Each son replaces the worst individual if better : the population keeps the best individuals evaluated, the failed one being dropped
+    std::vector<double> all;
+    for (int i=0; i<maxpop; i++)
+        all.push_back(pop_init.pop[i].cout);
+    for (int i=0; i<nsons; i++) {
+        if (!std::isnan(gensons.pop[i].cout))
+            all.push_back(gensons.pop[i].cout);
+    }
+    std::sort(all.begin(), all.end());
+    BOOST_CHECK( pop.size() == maxpop );
+    for (int i=0; i<maxpop; i++) {
+        BOOST_CHECK( pop.pop[i].cout == all[i] );
+        BOOST_CHECK( pop.pop[i].id != gensons.pop[2].id );
+    }
+    
+    //With several workers, every son is evaluated once, with a distinct id
+    std::atomic<int> ncalls_w(0);
+    std::atomic<int> nwrong_w(0);
+    auto cost_w = [&](const individual &son, const unsigned int &k) {
+        if (k >= 4)
+            nwrong_w++;
+        ncalls_w++;
+        return ellipsoid(son.p, p_opt);
+    };
+    id_start = idnumber;
+    steady_state(pop, gensons, idnumber, 5., 0.1, params, 4, cost_w);
+    BOOST_CHECK( ncalls_w == nsons );
+    BOOST_CHECK( nwrong_w == 0 );
+    BOOST_CHECK( idnumber == id_start + nsons );
+    std::set<int> ids;
+    for (int i=0; i<nsons; i++) {
+        ids.insert(gensons.pop[i].id);
+        BOOST_CHECK( (gensons.pop[i].id >= id_start)&&(gensons.pop[i].id < idnumber) );
+    }
+    BOOST_CHECK( ids.size() == (unsigned int)nsons );
+    for (int i=1; i<maxpop; i++)
+        BOOST_CHECK( pop.pop[i].cout >= pop.pop[i-1].cout );
+    BOOST_CHECK( pop.pop[0].cout <= best.back() );
+}
@@ -0,0 +1,198 @@
+/* This file is part of simcoon.
+
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tscript.cpp
+///@brief Test for the concurrent evaluation of the individuals in private worker folders, and for the sensitivity matrix
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "script"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <atomic>
+#include <armadillo>
+#include <boost/filesystem.hpp>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Identification/parameters.hpp>
+#include <simcoon/Simulation/Identification/individual.hpp>
+#include <simcoon/Simulation/Identification/generation.hpp>
+#include <simcoon/Simulation/Identification/script.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+//Ill-conditioned ellipsoid centered on p_opt
+static double ellipsoid(const vec &p, const vec &p_opt) {
+    double f = 0.;
+    for (unsigned int j=0; j<p.n_elem; j++)
+        f += pow(10., 3.*j/(p.n_elem-1.))*(p(j)-p_opt(j))*(p(j)-p_opt(j));
+    return f;
+}
+
+BOOST_AUTO_TEST_CASE( run_individuals_workers )
+{
+    arma_rng::set_seed(42);
+    string path_data = "data_workers";
+    string folder = "results_workers";
+    boost::filesystem::remove_all(path_data);
+    boost::filesystem::remove_all(folder);
+    boost::filesystem::create_directories(path_data + "/sub");
+    boost::filesystem::create_directories(folder);
+
+    //The optimum of the toy objective is read in the data folder (in a subfolder, to check the recursive copy)
+    vec p_opt = {2., 7., 4.5, 1., 8.};
+    ofstream out_opt(path_data + "/sub/p_opt.dat");
+    out_opt << p_opt.t();
+    out_opt.close();
+
+    BOOST_CHECK( worker_path("data_workers/", 2) == "data_workers_w2" );
+    BOOST_CHECK( worker_path(path_data, 0) == "data_workers_w0" );
+
+    const unsigned int nworkers = 4;
+    setup_workers(nworkers, path_data, folder);
+    for (unsigned int k=0; k<nworkers; k++) {
+        BOOST_CHECK( boost::filesystem::exists(worker_path(path_data, k) + "/sub/p_opt.dat") );
+        BOOST_CHECK( boost::filesystem::is_directory(worker_path(folder, k)) );
+    }
+
+    int n_param = 5;
+    int idnumber = 0;
+    generation gen(40, n_param, idnumber);
+    for (int i=0; i<gen.size(); i++)
+        gen.pop[i].p = 10.*randu(n_param);
+
+    //Toy objective: it reads the optimum in its data folder and writes the individual in its results folder. A worker never runs two individuals at once
+    std::atomic<int> busy[nworkers];
+    for (auto &b : busy)
+        b = 0;
+    std::atomic<bool> isolated(true);
+    unsigned int nworkers_run = nworkers;
+    auto toy = [&](const individual &ind, const string &folder_w, const string &path_data_w, const unsigned int &k) -> vec {
+        if (busy[k]++ != 0)
+            isolated = false;
+        string folder_k = (nworkers_run < 2) ? folder : worker_path(folder, k);
+        string path_data_k = (nworkers_run < 2) ? path_data : worker_path(path_data, k);
+        if ((folder_w != folder_k)||(path_data_w != path_data_k))
+            isolated = false;
+
+        vec p_opt_w = zeros(ind.p.n_elem);
+        ifstream in_opt(path_data_w + "/sub/p_opt.dat");
+        for (unsigned int j=0; j<p_opt_w.n_elem; j++)
+            in_opt >> p_opt_w(j);
+        ofstream out_ind(folder_w + "/ind_" + to_string(ind.id) + ".dat");
+        out_ind << ind.p.t();
+        out_ind.close();
+
+        busy[k]--;
+        vec v = {ellipsoid(ind.p, p_opt_w)};
+        return v;
+    };
+
+    vector<vec> vnum;
+    run_individuals(gen, folder, path_data, nworkers, vnum, toy);
+    BOOST_CHECK( isolated );
+    BOOST_CHECK( vnum.size() == 40 );
+
+    //Each individual was evaluated in exactly one worker folder
+    for (int i=0; i<gen.size(); i++) {
+        string ind_file = "/ind_" + to_string(gen.pop[i].id) + ".dat";
+        unsigned int nfound = 0;
+        for (unsigned int k=0; k<nworkers; k++) {
+            if (boost::filesystem::exists(worker_path(folder, k) + ind_file))
+                nfound++;
+        }
+        BOOST_CHECK( nfound == 1 );
+        BOOST_CHECK( !boost::filesystem::exists(folder + ind_file) );
+    }
+
+    //The sequential evaluation, in the folders themselves, gives the same results
+    nworkers_run = 1;
+    vector<vec> vnum_seq;
+    run_individuals(gen, folder, path_data, 1, vnum_seq, toy);
+    BOOST_CHECK( isolated );
+    BOOST_CHECK( vnum_seq.size() == vnum.size() );
+    for (int i=0; i<gen.size(); i++) {
+        BOOST_CHECK( boost::filesystem::exists(folder + "/ind_" + to_string(gen.pop[i].id) + ".dat") );
+        BOOST_CHECK( vnum[i].n_elem == 1 );
+        BOOST_CHECK( vnum[i](0) == vnum_seq[i](0) );
+        BOOST_CHECK( fabs(vnum[i](0) - ellipsoid(gen.pop[i].p, p_opt)) < 1.E-9*(1. + ellipsoid(gen.pop[i].p, p_opt)) );
+    }
+
+    //The worker folders are removed, the folders themselves are kept
+    clean_workers(nworkers, path_data, folder);
+    for (unsigned int k=0; k<nworkers; k++) {
+        BOOST_CHECK( !boost::filesystem::exists(worker_path(path_data, k)) );
+        BOOST_CHECK( !boost::filesystem::exists(worker_path(folder, k)) );
+    }
+    BOOST_CHECK( boost::filesystem::exists(path_data + "/sub/p_opt.dat") );
+    BOOST_CHECK( boost::filesystem::is_directory(folder) );
+
+    boost::filesystem::remove_all(path_data);
+    boost::filesystem::remove_all(folder);
+}
+
+BOOST_AUTO_TEST_CASE( calc_sensi_quadratic )
+{
+    //Quadratic model v = A*p + Q*(p%p), whose Jacobian is A + 2*Q*diag(p)
+    int n_param = 3;
+    std::vector<parameters> params;
+    for (int j=0; j<n_param; j++)
+        params.push_back(parameters(j, 0., 10.));
+    mat A = {{1., -2., 0.5}, {3., 0., -1.}, {0.2, 4., 2.}, {-1., 1., 1.}};
+    mat Q = {{0.5, 0., 0.}, {0., -1., 0.}, {0.3, 0.2, 0.1}, {0., 0., 0.}};
+    individual gboy(n_param, 0, 0.);
+    gboy.p = {2., 5., 3.};
+    mat J = A + 2.*Q*diagmat(gboy.p);
+    
+    auto model = [&](const individual &ind, const string &, const string &, const unsigned int &) -> vec {
+        vec v = A*ind.p + Q*(ind.p%ind.p);
+        return v;
+    };
+    auto run = [&](const unsigned int &nworkers) {
+        return [&, nworkers](const generation &gen, vector<vec> &vnum) {
+            run_individuals(gen, "results_sensi", "data_sensi", nworkers, vnum, model);
+        };
+    };
+    vec Dp_n = zeros(n_param);
+    
+    //Forward differences: the error is the second-order term Q*diag(delta)
+    vec vnum0;
+    vec delta;
+    mat S_fwd = calc_sensi(gboy, params, vnum0, Dp_n, delta, run(1), false);
+    BOOST_CHECK( norm(vnum0 - (A*gboy.p + Q*(gboy.p%gboy.p)),2) < 1.E-12*norm(vnum0,2) );
+    BOOST_CHECK( S_fwd.n_rows == 4 );
+    BOOST_CHECK( S_fwd.n_cols == (unsigned int)n_param );
+    BOOST_CHECK( norm(S_fwd - J - Q*diagmat(delta),"fro") < 1.E-6*norm(J,"fro") );
+    BOOST_CHECK( norm(S_fwd - J,"fro") > 1.E-6*norm(J,"fro") );
+    
+    //Central differences are exact for a quadratic model
+    vec delta_c;
+    mat S_cen = calc_sensi(gboy, params, vnum0, Dp_n, delta_c, run(1), true);
+    BOOST_CHECK( norm(S_cen - J,"fro") < 1.E-6*norm(J,"fro") );
+    BOOST_CHECK( norm(S_cen - J,"fro") < norm(S_fwd - J,"fro") );
+    
+    //The concurrent evaluation of the perturbations gives the same matrices
+    vec delta_w;
+    mat S_fwd_w = calc_sensi(gboy, params, vnum0, Dp_n, delta_w, run(4), false);
+    BOOST_CHECK( norm(S_fwd_w - S_fwd,"inf") == 0. );
+    mat S_cen_w = calc_sensi(gboy, params, vnum0, Dp_n, delta_w, run(4), true);
+    BOOST_CHECK( norm(S_cen_w - S_cen,"inf") == 0. );
+}
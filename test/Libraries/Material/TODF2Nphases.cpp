@@ -0,0 +1,193 @@
+/* This file is part of simcoon.
+
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file TODF2Nphases.cpp
+///@brief Test for the discretization of a phase according to an ODF or a PDF
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "ODF2Nphases"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <memory>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Continuum_mechanics/Functions/natural_basis.hpp>
+#include <simcoon/Continuum_mechanics/Material/peak.hpp>
+#include <simcoon/Continuum_mechanics/Material/ODF.hpp>
+#include <simcoon/Continuum_mechanics/Material/ODF2Nphases.hpp>
+#include <simcoon/Continuum_mechanics/Material/PDF.hpp>
+#include <simcoon/Continuum_mechanics/Material/PDF2Nphases.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/read.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+//Reference two-pass discretization: each bin is inserted in the vector of phases, then the concentrations are normalized
+phase_characteristics discretize_ODF_ref(const phase_characteristics &rve_init, ODF &odf_rve, const int &num_phase_disc, const int &nb_phases_disc, const int &angles_mat) {
+
+    phase_characteristics rve;
+    rve.copy(rve_init);
+
+    odf_rve.norm = 0.;
+    double dalpha = (odf_rve.limits(1) - odf_rve.limits(0))/double(nb_phases_disc);
+    double alpha = odf_rve.limits(0);
+
+    rve.sub_phases.erase(rve.sub_phases.begin()+num_phase_disc);
+    for (int i=0; i<nb_phases_disc; i++) {
+        phase_characteristics temp;
+        temp.copy(rve_init.sub_phases[num_phase_disc]);
+        fill_angles(alpha, temp, odf_rve, angles_mat);
+
+        if(alpha - odf_rve.limits(0) < dalpha)
+            temp.sptr_shape->concentration = dalpha/6. * (odf_rve.density(sim_pi+alpha-dalpha/2) + 4.*odf_rve.density(alpha) + odf_rve.density(alpha+dalpha/2));
+        else
+            temp.sptr_shape->concentration = dalpha/6. * (odf_rve.density(alpha-dalpha/2) + 4.*odf_rve.density(alpha) + odf_rve.density(alpha+dalpha/2));
+        odf_rve.norm += temp.sptr_shape->concentration;
+
+        rve.sub_phases.insert(rve.sub_phases.begin()+i+num_phase_disc, temp);
+        alpha += dalpha;
+    }
+    for(int i=0; i<nb_phases_disc; i++) {
+        rve.sub_phases[i+num_phase_disc].sptr_shape->concentration *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / odf_rve.norm);
+    }
+    for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
+        rve.sub_phases[i].sptr_matprops->number = i;
+    }
+    return rve;
+}
+
+phase_characteristics discretize_PDF_ref(const phase_characteristics &rve_init, PDF &pdf_rve, const int &num_phase_disc, const int &nb_phases_disc) {
+
+    phase_characteristics rve;
+    rve.copy(rve_init);
+
+    pdf_rve.norm = 0.;
+    double dalpha = (pdf_rve.limits(1) - pdf_rve.limits(0))/double(nb_phases_disc);
+    double alpha = pdf_rve.limits(0);
+
+    rve.sub_phases.erase(rve.sub_phases.begin()+num_phase_disc);
+    for (int i=0; i<nb_phases_disc; i++) {
+        phase_characteristics temp;
+        temp.copy(rve_init.sub_phases[num_phase_disc]);
+        fill_parameters(alpha, temp, pdf_rve);
+
+        temp.sptr_shape->concentration = dalpha/6. * (pdf_rve.density(alpha-dalpha/2) + 4.*pdf_rve.density(alpha) + pdf_rve.density(alpha+dalpha/2));
+        pdf_rve.norm += temp.sptr_shape->concentration;
+
+        rve.sub_phases.insert(rve.sub_phases.begin()+i+num_phase_disc, temp);
+        alpha += dalpha;
+    }
+    for(int i=0; i<nb_phases_disc; i++) {
+        rve.sub_phases[i+num_phase_disc].sptr_shape->concentration *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / pdf_rve.norm);
+    }
+    for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
+        rve.sub_phases[i].sptr_matprops->number = i;
+    }
+    return rve;
+}
+
+//The phases are compared one by one: number, concentration, material angles and properties, and geometry
+void check_phases(const phase_characteristics &rve, const phase_characteristics &rve_ref) {
+
+    BOOST_CHECK( rve.sub_phases.size() == rve_ref.sub_phases.size() );
+    for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
+        const phase_characteristics &r = rve.sub_phases[i];
+        const phase_characteristics &r_ref = rve_ref.sub_phases[i];
+        BOOST_CHECK( r.sptr_matprops->number == r_ref.sptr_matprops->number );
+        BOOST_CHECK( r.sptr_matprops->umat_name == r_ref.sptr_matprops->umat_name );
+        BOOST_CHECK( fabs(r.sptr_shape->concentration - r_ref.sptr_shape->concentration) < 1.E-12 );
+        BOOST_CHECK( fabs(r.sptr_matprops->psi_mat - r_ref.sptr_matprops->psi_mat) < 1.E-12 );
+        BOOST_CHECK( fabs(r.sptr_matprops->theta_mat - r_ref.sptr_matprops->theta_mat) < 1.E-12 );
+        BOOST_CHECK( fabs(r.sptr_matprops->phi_mat - r_ref.sptr_matprops->phi_mat) < 1.E-12 );
+        BOOST_CHECK( norm(r.sptr_matprops->props - r_ref.sptr_matprops->props,"inf") < 1.E-12*norm(r_ref.sptr_matprops->props,"inf") );
+
+        auto ell = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
+        auto ell_ref = std::dynamic_pointer_cast<ellipsoid>(r_ref.sptr_shape);
+        BOOST_CHECK( fabs(ell->psi_geom - ell_ref->psi_geom) < 1.E-12 );
+        BOOST_CHECK( fabs(ell->theta_geom - ell_ref->theta_geom) < 1.E-12 );
+        BOOST_CHECK( fabs(ell->phi_geom - ell_ref->phi_geom) < 1.E-12 );
+        BOOST_CHECK( fabs(ell->a1 - ell_ref->a1) < 1.E-12 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( discretize_ODF_two_pass )
+{
+    //Three ellipsoidal phases of data/Nellipsoids0.dat: the phase 1 is discretized, the phase 2 follows it
+    vec props = {3, 0, 20, 20, 0};
+    natural_basis nb;
+    phase_characteristics rve_init;
+    rve_init.construct(0,1);
+    rve_init.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve_init.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    read_ellipsoid(rve_init, "data", "Nellipsoids0.dat");
+
+    std::vector<peak> peaks;
+    peaks.push_back(peak(0, 3, 0.5, 0.3, 0., 1., vec(), vec()));
+    peaks.push_back(peak(1, 4, 2., 0., 0.4, 0.5, vec(), vec()));
+    ODF odf_rve(0, true, 0., sim_pi);
+    odf_rve.peaks = peaks;
+    ODF odf_ref = odf_rve;
+
+    int num_phase_disc = 1;
+    for (int nb_phases_disc : {1, 7, 36}) {
+        phase_characteristics rve = discretize_ODF(rve_init, odf_rve, num_phase_disc, nb_phases_disc, 1);
+        phase_characteristics rve_ref = discretize_ODF_ref(rve_init, odf_ref, num_phase_disc, nb_phases_disc, 1);
+        BOOST_CHECK( rve.sub_phases.size() == 2 + nb_phases_disc );
+        BOOST_CHECK( fabs(odf_rve.norm - odf_ref.norm) < 1.E-12*odf_ref.norm );
+        check_phases(rve, rve_ref);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( discretize_PDF_two_pass )
+{
+    vec props = {3, 0, 20, 20, 0};
+    natural_basis nb;
+    phase_characteristics rve_init;
+    rve_init.construct(0,1);
+    rve_init.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve_init.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    read_ellipsoid(rve_init, "data", "Nellipsoids0.dat");
+
+    //Distribution of the Young modulus (property 0) of the phase 1
+    std::vector<peak> peaks;
+    peaks.push_back(peak(0, 3, 70000., 8000., 0., 1., vec(), vec()));
+    PDF pdf_rve(0, 40000., 100000.);
+    pdf_rve.peaks = peaks;
+    PDF pdf_ref = pdf_rve;
+
+    int num_phase_disc = 1;
+    for (int nb_phases_disc : {1, 7, 36}) {
+        phase_characteristics rve = discretize_PDF(rve_init, pdf_rve, num_phase_disc, nb_phases_disc);
+        phase_characteristics rve_ref = discretize_PDF_ref(rve_init, pdf_ref, num_phase_disc, nb_phases_disc);
+        BOOST_CHECK( rve.sub_phases.size() == 2 + nb_phases_disc );
+        BOOST_CHECK( fabs(pdf_rve.norm - pdf_ref.norm) < 1.E-12*pdf_ref.norm );
+        check_phases(rve, rve_ref);
+    }
+
+    //The volume fraction of the discretized phase is kept
+    phase_characteristics rve = discretize_PDF(rve_init, pdf_rve, num_phase_disc, 10);
+    double c_disc = 0.;
+    for (int i=0; i<10; i++) {
+        c_disc += rve.sub_phases[num_phase_disc + i].sptr_shape->concentration;
+    }
+    BOOST_CHECK( fabs(c_disc - 0.3) < 1.E-9 );
+}
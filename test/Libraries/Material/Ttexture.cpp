@@ -0,0 +1,164 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Ttexture.cpp
+///@brief Test for the shared discretized textures
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "texture"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Continuum_mechanics/Functions/natural_basis.hpp>
+#include <simcoon/Continuum_mechanics/Material/peak.hpp>
+#include <simcoon/Continuum_mechanics/Material/ODF.hpp>
+#include <simcoon/Continuum_mechanics/Material/ODF2Nphases.hpp>
+#include <simcoon/Continuum_mechanics/Material/texture.hpp>
+#include <simcoon/Continuum_mechanics/Micromechanics/multiphase.hpp>
+#include <simcoon/Simulation/Geometry/ellipsoid.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Phase/read.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( texture_build )
+{
+    //Three ellipsoidal phases: the phase 1 is discretized, the phase 2 follows it
+    vec props = {3, 0, 20, 20, 0};
+    natural_basis nb;
+    phase_characteristics rve_init;
+    rve_init.construct(0,1);
+    rve_init.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve_init.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    read_ellipsoid(rve_init, "data", "Nellipsoids0.dat");
+    
+    std::vector<peak> peaks;
+    peaks.push_back(peak(0, 2, 0.5, 0.2, 0., 1., vec(), vec()));
+    ODF odf_rve(0, true, 0., sim_pi);
+    odf_rve.peaks = peaks;
+    
+    int num_phase_disc = 1;
+    int nb_phases_disc = 10;
+    phase_characteristics rve_ref = discretize_ODF(rve_init, odf_rve, num_phase_disc, nb_phases_disc, 1);
+    
+    //The shared texture gives the same phases as discretize_ODF
+    texture tex(rve_init, num_phase_disc, odf_rve, nb_phases_disc, 1);
+    phase_characteristics rve;
+    rve.copy(rve_init);
+    tex.build(rve);
+    
+    BOOST_CHECK( rve.sub_phases.size() == rve_ref.sub_phases.size() );
+    BOOST_CHECK( rve.sub_phases.size() == 12 );
+    for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
+        const phase_characteristics &r = rve.sub_phases[i];
+        const phase_characteristics &r_ref = rve_ref.sub_phases[i];
+        BOOST_CHECK( r.sptr_matprops->number == int(i) );
+        BOOST_CHECK( r.sptr_matprops->number == r_ref.sptr_matprops->number );
+        BOOST_CHECK( fabs(r.sptr_shape->concentration - r_ref.sptr_shape->concentration) < 1.E-12 );
+        BOOST_CHECK( fabs(r.sptr_matprops->psi_mat - r_ref.sptr_matprops->psi_mat) < 1.E-12 );
+        BOOST_CHECK( fabs(r.sptr_matprops->theta_mat - r_ref.sptr_matprops->theta_mat) < 1.E-12 );
+        BOOST_CHECK( fabs(r.sptr_matprops->phi_mat - r_ref.sptr_matprops->phi_mat) < 1.E-12 );
+        
+        auto ell = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
+        auto ell_ref = std::dynamic_pointer_cast<ellipsoid>(r_ref.sptr_shape);
+        BOOST_CHECK( fabs(ell->psi_geom - ell_ref->psi_geom) < 1.E-12 );
+        BOOST_CHECK( fabs(ell->theta_geom - ell_ref->theta_geom) < 1.E-12 );
+        BOOST_CHECK( fabs(ell->phi_geom - ell_ref->phi_geom) < 1.E-12 );
+        BOOST_CHECK( fabs(ell->a1 - ell_ref->a1) < 1.E-12 );
+    }
+    
+    //The volume fraction of the discretized phase is kept
+    double c_disc = 0.;
+    for (int i=0; i<nb_phases_disc; i++) {
+        c_disc += rve.sub_phases[num_phase_disc + i].sptr_shape->concentration;
+    }
+    BOOST_CHECK( fabs(c_disc - 0.3) < 1.E-9 );
+}
+
+BOOST_AUTO_TEST_CASE( texture_umat_multi )
+{
+    //Microstructure and texture files of the material point (data/Nellipsoids40.dat, data/Ntexture40.dat)
+    std::ifstream ell_in("data/Nellipsoids0.dat");
+    std::ofstream ell_out("data/Nellipsoids40.dat");
+    ell_out << ell_in.rdbuf();
+    ell_out.close();
+    std::ofstream peaks_out("data/peaks40.dat");
+    peaks_out << "Number\tMethod\tmean\ts_dev\twidth\tampl\tnparams\tparams\n";
+    peaks_out << "0\t3\t30\t20\t0\t1\t0\n";
+    peaks_out.close();
+    std::ofstream tex_out("data/Ntexture40.dat");
+    tex_out << "Number\tNphases\tAngle\tangle_min\tangle_max\tangles_mat\tpeaks\n";
+    tex_out << "1\t10\t0\t0\t180\t1\tpeaks40.dat\n";
+    tex_out.close();
+    
+    vec props = {3, 40, 20, 20, 0};
+    natural_basis nb;
+    mat DR = eye(3,3);
+    double tnew_dt = 1.;
+    
+    //Without the texture mode, the file is not looked up
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    rve.global2local();
+    bool start = true;
+    umat_multi(rve, DR, 0., 1., 3, 3, start, 0, tnew_dt, 101, false, false);
+    BOOST_CHECK( rve.sub_phases.size() == 3 );
+    BOOST_CHECK( !rve.texture_read );
+    BOOST_CHECK( rve.sptr_texture == nullptr );
+    
+    //With the texture mode, the phase 1 is discretized into the 10 orientations
+    phase_characteristics rve_tex;
+    rve_tex.construct(0,1);
+    rve_tex.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve_tex.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    rve_tex.global2local();
+    start = true;
+    umat_multi(rve_tex, DR, 0., 1., 3, 3, start, 0, tnew_dt, 101, false, true);
+    BOOST_CHECK( rve_tex.texture_read );
+    BOOST_CHECK( rve_tex.sptr_texture != nullptr );
+    BOOST_CHECK( rve_tex.sub_phases.size() == 12 );
+    
+    //A new start of the same material point reuses its texture, without looking up the file again
+    std::remove("data/Ntexture40.dat");
+    start = true;
+    umat_multi(rve_tex, DR, 0., 1., 3, 3, start, 0, tnew_dt, 101, false, true);
+    BOOST_CHECK( rve_tex.sptr_texture != nullptr );
+    BOOST_CHECK( rve_tex.sub_phases.size() == 12 );
+    
+    //A material point without a texture file records the lookup, and keeps its phases
+    phase_characteristics rve_none;
+    rve_none.construct(0,1);
+    rve_none.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve_none.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), eye(3,3), eye(3,3), 273.15, 0., 1, zeros(1), zeros(1), nb);
+    rve_none.global2local();
+    start = true;
+    umat_multi(rve_none, DR, 0., 1., 3, 3, start, 0, tnew_dt, 101, false, true);
+    BOOST_CHECK( rve_none.texture_read );
+    BOOST_CHECK( rve_none.sptr_texture == nullptr );
+    BOOST_CHECK( rve_none.sub_phases.size() == 3 );
+}
@@ -0,0 +1,80 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tnum_solve.cpp
+///@brief Test for the numerical solvers
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "num_solve"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/num_solve.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( Anderson_mixing_linear )
+{
+    //Linear fixed point x = M*x + b, whose solution is (I - M)^-1*b
+    mat Q;
+    mat R;
+    mat A = {{1., 0.2, 0.1, 0., 0.3, 0.}, {0.5, 1., 0., 0.2, 0., 0.1}, {0., 0.1, 1., 0.4, 0., 0.2}, {0.3, 0., 0.2, 1., 0.1, 0.}, {0., 0.4, 0., 0.1, 1., 0.3}, {0.2, 0., 0.3, 0., 0.1, 1.}};
+    qr(Q, R, A);
+    mat M = Q*diagmat(vec({0.95, 0.9, 0.8, -0.7, 0.5, 0.3}))*Q.t();
+    vec b = {1., -2., 0.5, 3., -1., 2.};
+    vec x_exact = solve(eye(6,6) - M, b);
+    
+    //Plain fixed-point iteration: contraction of ratio 0.95
+    vec x = zeros(6);
+    int nbiter_plain = 0;
+    while ((norm(M*x + b - x,2) > 1.E-10)&&(nbiter_plain < 10000)) {
+        x = M*x + b;
+        nbiter_plain++;
+    }
+    BOOST_CHECK( norm(x - x_exact,2) < 1.E-8 );
+    
+    //With a history as long as the dimension, the mixing of a linear map converges in a few iterations
+    mat dG;
+    mat dF;
+    vec g_prev;
+    vec f_prev;
+    x = zeros(6);
+    int nbiter = 0;
+    while ((norm(M*x + b - x,2) > 1.E-10)&&(nbiter < 100)) {
+        x = Anderson_mixing(x, M*x + b, dG, dF, g_prev, f_prev, 6);
+        nbiter++;
+    }
+    BOOST_CHECK( norm(x - x_exact,2) < 1.E-8 );
+    BOOST_CHECK( nbiter <= 12 );
+    BOOST_CHECK( nbiter < nbiter_plain );
+    BOOST_CHECK( dF.n_cols <= 6 );
+    
+    //Without history, the mixing is the plain iteration
+    dG.reset();
+    dF.reset();
+    g_prev.reset();
+    f_prev.reset();
+    x = {1., 2., 3., 4., 5., 6.};
+    vec x_new = Anderson_mixing(x, M*x + b, dG, dF, g_prev, f_prev, 6);
+    BOOST_CHECK( norm(x_new - (M*x + b),2) < 1.E-12 );
+    x_new = Anderson_mixing(x, M*x + b, dG, dF, g_prev, f_prev, 0);
+    BOOST_CHECK( norm(x_new - (M*x + b),2) < 1.E-12 );
+}
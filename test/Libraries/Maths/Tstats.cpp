@@ -0,0 +1,71 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tstats.cpp
+///@brief Test for the vectorized density functions and the ODF densities
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "stats"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Maths/stats.hpp>
+#include <simcoon/Continuum_mechanics/Material/peak.hpp>
+#include <simcoon/Continuum_mechanics/Material/ODF.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( vectorized_densities )
+{
+    //Each peak method evaluated for a vector of angles gives the values of the scalar evaluation
+    vec theta = linspace(0., sim_pi, 10001);
+    
+    std::vector<peak> peaks;
+    peaks.push_back(peak(0, 1, 0.3, 0., 0., 0., {1., 0.5, 2., 1.}, vec()));
+    peaks.push_back(peak(1, 2, 0.5, 0.2, 0., 1.5, vec(), vec()));
+    peaks.push_back(peak(2, 3, 1.2, 0.3, 0., 2., vec(), vec()));
+    peaks.push_back(peak(3, 4, 2.0, 0., 0.4, 1., vec(), vec()));
+    peaks.push_back(peak(4, 5, 0.8, 0.2, 0.3, 1., {0.4}, vec()));
+    peaks.push_back(peak(5, 6, 2.5, 0., 0.5, 0., {2., 1.5}, vec()));
+    peaks.push_back(peak(6, 7, 0., 0., 0., 0., vec(), vec()));
+    
+    for (auto &p : peaks) {
+        vec y_ODF = p.get_density_ODF(theta);
+        vec y_PDF = p.get_density_PDF(theta);
+        for (unsigned int i=0; i<theta.n_elem; i++) {
+            double y_ODF_i = p.get_density_ODF(theta(i));
+            double y_PDF_i = p.get_density_PDF(theta(i));
+            BOOST_CHECK( fabs(y_ODF(i) - y_ODF_i) <= 1.E-9*(1. + fabs(y_ODF_i)) );
+            BOOST_CHECK( fabs(y_PDF(i) - y_PDF_i) <= 1.E-9*(1. + fabs(y_PDF_i)) );
+        }
+    }
+    
+    //The ODF density is the sum of the densities of its peaks, with or without the thread pool
+    ODF odf_rve(0, true, 0., sim_pi);
+    odf_rve.peaks = peaks;
+    vec y = odf_rve.density(theta);
+    vec y_parallel = odf_rve.density(theta, true);
+    BOOST_CHECK( norm(y_parallel - y,"inf") <= 1.E-12*norm(y,"inf") );
+    for (unsigned int i=0; i<theta.n_elem; i+=100) {
+        BOOST_CHECK( fabs(y(i) - odf_rve.density(theta(i))) <= 1.E-9*(1. + fabs(y(i))) );
+    }
+}
@@ -0,0 +1,125 @@
+/* This file is part of simcoon.
+ 
+ simcoon is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ simcoon is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with simcoon.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tsolver_memory.cpp
+///@brief Test for the solver writing its global results in a stream, on a multiphase material
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "solver_memory"
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <math.h>
+#include <armadillo>
+#include <simcoon/parameter.hpp>
+#include <simcoon/Simulation/Phase/phase_characteristics.hpp>
+#include <simcoon/Simulation/Solver/read.hpp>
+#include <simcoon/Simulation/Solver/block.hpp>
+#include <simcoon/Simulation/Solver/solver.hpp>
+#include <simcoon/Simulation/Solver/column_buffer.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace simcoon;
+
+BOOST_AUTO_TEST_CASE( define_output_stream )
+{
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sub_phases.resize(2);
+    for(auto &r : rve.sub_phases) {
+        r.construct(0,1);
+        r.sub_phases.resize(1);
+        r.sub_phases[0].construct(0,1);
+    }
+    
+    std::shared_ptr<std::ostream> sptr_out = make_shared<std::ostream>(std::cout.rdbuf());
+    rve.define_output_stream(sptr_out, "global");
+    rve.define_output_stream(make_shared<std::ostream>(nullptr), "local");
+    
+    //The rve writes in the stream provided, all the sub-phases have a stream that discards their results
+    BOOST_CHECK( rve.sptr_out_global == sptr_out );
+    BOOST_CHECK( rve.sptr_out_local );
+    for(auto &r : rve.sub_phases) {
+        BOOST_CHECK( (r.sptr_out_global)&&(r.sptr_out_global != sptr_out)&&(r.sptr_out_global->rdbuf() == nullptr) );
+        BOOST_CHECK( (r.sptr_out_local)&&(r.sptr_out_local->rdbuf() == nullptr) );
+        BOOST_CHECK( (r.sub_phases[0].sptr_out_global)&&(r.sub_phases[0].sptr_out_global->rdbuf() == nullptr) );
+        BOOST_CHECK( (r.sub_phases[0].sptr_out_local)&&(r.sub_phases[0].sptr_out_local->rdbuf() == nullptr) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( solver_memory_MIMTN )
+{
+    string path_data = "data";
+    string path_results = "results";
+    string outputfile = "results_job.txt";
+    string pathfile = "path.txt";
+    string materialfile = "material.dat";
+    
+    string umat_name;
+    unsigned int nprops = 0;
+    unsigned int nstatev = 0;
+    vec props;
+    
+    double psi_rve = 0.;
+    double theta_rve = 0.;
+    double phi_rve = 0.;
+    
+    int solver_type = 0;
+    int corate_type = 0;
+    double div_tnew_dt_solver = 0.;
+    double mul_tnew_dt_solver = 0.;
+    int miniter_solver = 0;
+    int maxiter_solver = 0;
+    int inforce_solver = 0;
+    double precision_solver = 0.;
+    double lambda_solver = 0.;
+    
+    solver_essentials(solver_type, corate_type, path_data);
+    solver_control(div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data);
+    read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
+    
+    std::vector<block> blocks;
+    double T_init = 0.;
+    read_path(blocks, T_init, path_data, pathfile);
+    
+    //Time, e11 and s11 of the global results
+    Col<int> columns = {4, 8, 14};
+    column_buffer buffer(columns);
+    std::shared_ptr<std::ostream> sptr_out = make_shared<std::ostream>(&buffer);
+    
+    //The Mori-Tanaka rve has sub-phases, that also write their results
+    solver(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, solver_type, corate_type, div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, blocks, T_init, path_data, path_results, outputfile, sptr_out);
+    sptr_out->flush();
+    
+    mat C;
+    C.load("comparison/results_job_global-0.txt");
+    mat R = buffer.data();
+    
+    BOOST_CHECK( R.n_rows == C.n_rows );
+    BOOST_CHECK( R.n_cols == columns.n_elem );
+    for (unsigned int i=0; i<std::min(C.n_rows, R.n_rows); i++) {
+        for (unsigned int j=0; j<columns.n_elem; j++) {
+            BOOST_CHECK( fabs(C(i,columns(j)) - R(i,j)) < 1.E-6 );
+        }
+    }
+}